@@ -0,0 +1,323 @@
+// ======================================================================
+// \title  BufferPool.cpp
+// \brief  cpp file for BufferPool component implementation class
+// ======================================================================
+
+#include <FlightComputer/BufferPool/BufferPool.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace FlightComputer {
+
+  namespace {
+    const U32 CACHE_LINE = 64;
+
+    // Buffer context layout: pool id | size class | buffer index
+    const U32 POOL_SHIFT = 16;
+    const U32 CLASS_SHIFT = 14;
+    const U32 CLASS_MASK = (1U << (POOL_SHIFT - CLASS_SHIFT)) - 1;
+    const U32 INDEX_MASK = (1U << CLASS_SHIFT) - 1;
+
+    static_assert(BufferPool::MAX_SIZE_CLASSES <= CLASS_MASK + 1, "size class does not fit the buffer context");
+    static_assert(BufferPool::MAX_BUFFERS_PER_CLASS <= INDEX_MASK + 1, "buffer index does not fit the buffer context");
+
+    // Pools a single thread can hold a cache in
+    const U32 MAX_BINDINGS = 4;
+
+    struct CacheBinding {
+      const void* pool;
+      void* cache; //!< nullptr if the pool had no cache left for this thread
+    };
+    thread_local CacheBinding t_bindings[MAX_BINDINGS];
+
+    U32 roundUpToLine(const U32 size) {
+      return (size + CACHE_LINE - 1) & ~(CACHE_LINE - 1);
+    }
+  }
+
+  BufferPool ::
+    BufferPool(
+        const char *const compName
+    ) : BufferPoolComponentBase(compName),
+        m_poolId(0),
+        m_allocatorId(0),
+        m_allocator(nullptr),
+        m_memory(nullptr),
+        m_numClasses(0),
+        m_numThreadCaches(0),
+        m_cachesClaimed(0),
+        m_allocFailures(0)
+  {
+    for (U32 cls = 0; cls < MAX_SIZE_CLASSES; cls++) {
+      m_classes[cls].storage = nullptr;
+      m_classes[cls].bufferSize = 0;
+      m_classes[cls].stride = 0;
+      m_classes[cls].numBuffers = 0;
+      m_classes[cls].allocated = nullptr;
+      m_classes[cls].inUse.store(0);
+      m_classes[cls].highWater.store(0);
+      m_classes[cls].exhausted.store(0);
+    }
+    for (U32 c = 0; c < MAX_THREAD_CACHES; c++) {
+      for (U32 cls = 0; cls < MAX_SIZE_CLASSES; cls++) {
+        m_caches[c].counts[cls] = 0;
+      }
+      m_caches[c].hits.store(0);
+    }
+  }
+
+  BufferPool ::~BufferPool() {
+    cleanup();
+  }
+
+  void BufferPool ::
+    init(
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    BufferPoolComponentBase::init(instance);
+  }
+
+  void BufferPool ::
+    setup(
+        const U16 poolId,
+        const NATIVE_UINT_TYPE allocatorId,
+        Fw::MemAllocator& allocator,
+        const SizeClass classes[],
+        const U32 numClasses,
+        const U32 numThreadCaches
+    )
+  {
+    FW_ASSERT(m_memory == nullptr);
+    FW_ASSERT(classes != nullptr);
+    FW_ASSERT(numClasses > 0 && numClasses <= MAX_SIZE_CLASSES, numClasses);
+    FW_ASSERT(numThreadCaches <= MAX_THREAD_CACHES, numThreadCaches);
+
+    // Alignment slack, then every class's buffers followed by every class's free list links and allocated flags
+    NATIVE_UINT_TYPE total = CACHE_LINE - 1;
+    for (U32 cls = 0; cls < numClasses; cls++) {
+      FW_ASSERT(classes[cls].numBuffers <= MAX_BUFFERS_PER_CLASS, classes[cls].numBuffers);
+      FW_ASSERT(cls == 0 || classes[cls].bufferSize > classes[cls - 1].bufferSize, cls);
+      total += roundUpToLine(classes[cls].bufferSize) * classes[cls].numBuffers;
+      total += (sizeof(std::atomic<U32>) + sizeof(std::atomic<U8>)) * classes[cls].numBuffers;
+    }
+
+    NATIVE_UINT_TYPE allocated = total;
+    bool recoverable = false;
+    m_memory = allocator.allocate(allocatorId, allocated, recoverable);
+    FW_ASSERT(m_memory != nullptr);
+    FW_ASSERT(allocated >= total, allocated, total);
+    // Write every page now so the first buffers handed out at runtime do not fault
+    (void) memset(m_memory, 0, allocated);
+
+    m_poolId = poolId;
+    m_allocatorId = allocatorId;
+    m_allocator = &allocator;
+    m_numClasses = numClasses;
+    m_numThreadCaches = numThreadCaches;
+
+    const uintptr_t base = reinterpret_cast<uintptr_t>(m_memory);
+    U8* cursor = reinterpret_cast<U8*>((base + CACHE_LINE - 1) & ~static_cast<uintptr_t>(CACHE_LINE - 1));
+    for (U32 cls = 0; cls < numClasses; cls++) {
+      Class& sizeClass = m_classes[cls];
+      sizeClass.bufferSize = classes[cls].bufferSize;
+      sizeClass.stride = roundUpToLine(classes[cls].bufferSize);
+      sizeClass.numBuffers = classes[cls].numBuffers;
+      sizeClass.storage = cursor;
+      cursor += sizeClass.stride * sizeClass.numBuffers;
+    }
+    for (U32 cls = 0; cls < numClasses; cls++) {
+      Class& sizeClass = m_classes[cls];
+      std::atomic<U32>* links = reinterpret_cast<std::atomic<U32>*>(cursor);
+      for (U32 index = 0; index < sizeClass.numBuffers; index++) {
+        (void) new (&links[index]) std::atomic<U32>(FreeList::EMPTY);
+      }
+      sizeClass.freeList.setup(links, sizeClass.numBuffers);
+      cursor += sizeof(std::atomic<U32>) * sizeClass.numBuffers;
+    }
+    for (U32 cls = 0; cls < numClasses; cls++) {
+      Class& sizeClass = m_classes[cls];
+      sizeClass.allocated = reinterpret_cast<std::atomic<U8>*>(cursor);
+      for (U32 index = 0; index < sizeClass.numBuffers; index++) {
+        (void) new (&sizeClass.allocated[index]) std::atomic<U8>(0);
+      }
+      cursor += sizeof(std::atomic<U8>) * sizeClass.numBuffers;
+    }
+  }
+
+  void BufferPool ::cleanup() {
+    if (m_memory == nullptr) {
+      return;
+    }
+    m_allocator->deallocate(m_allocatorId, m_memory);
+    m_memory = nullptr;
+    m_numClasses = 0;
+    for (U32 cls = 0; cls < MAX_SIZE_CLASSES; cls++) {
+      m_classes[cls].allocated = nullptr;
+    }
+    // Threads stay bound to their cache, it just no longer holds anything
+    for (U32 c = 0; c < MAX_THREAD_CACHES; c++) {
+      for (U32 cls = 0; cls < MAX_SIZE_CLASSES; cls++) {
+        m_caches[c].counts[cls] = 0;
+      }
+    }
+  }
+
+  BufferPool::ThreadCache* BufferPool ::threadCache() {
+    U32 unused = MAX_BINDINGS;
+    for (U32 b = 0; b < MAX_BINDINGS; b++) {
+      if (t_bindings[b].pool == this) {
+        return static_cast<ThreadCache*>(t_bindings[b].cache);
+      }
+      if (t_bindings[b].pool == nullptr && unused == MAX_BINDINGS) {
+        unused = b;
+      }
+    }
+    if (unused == MAX_BINDINGS) {
+      return nullptr;
+    }
+    // First call from this thread: claim a cache, or remember that there was none
+    const U32 claimed = m_cachesClaimed.fetch_add(1, std::memory_order_relaxed);
+    t_bindings[unused].pool = this;
+    t_bindings[unused].cache = (claimed < m_numThreadCaches) ? &m_caches[claimed] : nullptr;
+    return static_cast<ThreadCache*>(t_bindings[unused].cache);
+  }
+
+  U32 BufferPool ::take(ThreadCache* cache, const U32 cls) {
+    if (cache != nullptr && cache->counts[cls] > 0) {
+      // Single writer, so no read-modify-write is needed to publish the count
+      cache->hits.store(cache->hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return cache->entries[cls][--cache->counts[cls]];
+    }
+    return m_classes[cls].freeList.pop();
+  }
+
+  void BufferPool ::give(ThreadCache* cache, const U32 cls, const U32 index) {
+    if (cache != nullptr && cache->counts[cls] < CACHE_DEPTH) {
+      cache->hits.store(cache->hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      cache->entries[cls][cache->counts[cls]++] = index;
+      return;
+    }
+    m_classes[cls].freeList.push(index);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void BufferPool ::
+    bufferSendIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    // Failed gets hand out buffers with no data; callers may pass them back unchecked
+    if (fwBuffer.getData() == nullptr) {
+      return;
+    }
+
+    // A buffer from another pool, or one whose context was overwritten, is reported and left alone
+    const U32 context = fwBuffer.getContext();
+    const U32 cls = (context >> CLASS_SHIFT) & CLASS_MASK;
+    const U32 index = context & INDEX_MASK;
+    if ((context >> POOL_SHIFT) != m_poolId || cls >= m_numClasses || index >= m_classes[cls].numBuffers) {
+      log_WARNING_HI_ForeignBuffer(context);
+      return;
+    }
+    Class& sizeClass = m_classes[cls];
+    // Users may have advanced the data pointer (e.g. past a header), so only require it to be inside the buffer
+    const U8* const start = sizeClass.storage + index * sizeClass.stride;
+    if (fwBuffer.getData() < start || fwBuffer.getData() >= start + sizeClass.stride) {
+      log_WARNING_HI_ForeignBuffer(context);
+      return;
+    }
+    // Only one of two returns of the same buffer sees its flag set, so the index is never listed twice
+    if (sizeClass.allocated[index].exchange(0, std::memory_order_relaxed) == 0) {
+      log_WARNING_HI_DoubleReturn(context);
+      return;
+    }
+
+    (void) sizeClass.inUse.fetch_sub(1, std::memory_order_relaxed);
+    give(threadCache(), cls, index);
+  }
+
+  Fw::Buffer BufferPool ::
+    bufferGetCallee_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    FW_ASSERT(m_numClasses > 0);
+
+    U32 first = m_numClasses;
+    for (U32 cls = 0; cls < m_numClasses; cls++) {
+      if (m_classes[cls].bufferSize >= size) {
+        first = cls;
+        break;
+      }
+    }
+    if (first == m_numClasses) {
+      (void) m_allocFailures.fetch_add(1, std::memory_order_relaxed);
+      log_WARNING_HI_RequestTooLarge(size, m_classes[m_numClasses - 1].bufferSize);
+      return Fw::Buffer();
+    }
+
+    // Smallest fitting class first, then larger ones rather than failing the request
+    ThreadCache* cache = threadCache();
+    for (U32 cls = first; cls < m_numClasses; cls++) {
+      Class& sizeClass = m_classes[cls];
+      const U32 index = take(cache, cls);
+      if (index == FreeList::EMPTY) {
+        if (cls == first) {
+          (void) sizeClass.exhausted.fetch_add(1, std::memory_order_relaxed);
+        }
+        continue;
+      }
+      const U8 wasAllocated = sizeClass.allocated[index].exchange(1, std::memory_order_relaxed);
+      FW_ASSERT(wasAllocated == 0, cls, index);
+
+      const U32 inUse = sizeClass.inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+      U32 highWater = sizeClass.highWater.load(std::memory_order_relaxed);
+      while (inUse > highWater &&
+             !sizeClass.highWater.compare_exchange_weak(highWater, inUse, std::memory_order_relaxed)) {
+      }
+
+      const U32 context = (static_cast<U32>(m_poolId) << POOL_SHIFT) | (cls << CLASS_SHIFT) | index;
+      return Fw::Buffer(sizeClass.storage + index * sizeClass.stride, size, context);
+    }
+
+    const U32 failures = m_allocFailures.fetch_add(1, std::memory_order_relaxed) + 1;
+    log_WARNING_HI_PoolExhausted(size, failures);
+    return Fw::Buffer();
+  }
+
+  void BufferPool ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    BufferPool_ClassCounts inUse;
+    BufferPool_ClassCounts highWater;
+    BufferPool_ClassCounts exhausted;
+    for (U32 cls = 0; cls < MAX_SIZE_CLASSES; cls++) {
+      inUse[cls] = m_classes[cls].inUse.load(std::memory_order_relaxed);
+      highWater[cls] = m_classes[cls].highWater.load(std::memory_order_relaxed);
+      exhausted[cls] = m_classes[cls].exhausted.load(std::memory_order_relaxed);
+    }
+    U32 hits = 0;
+    for (U32 c = 0; c < MAX_THREAD_CACHES; c++) {
+      hits += m_caches[c].hits.load(std::memory_order_relaxed);
+    }
+
+    tlmWrite_InUse(inUse);
+    tlmWrite_HighWater(highWater);
+    tlmWrite_ClassExhausted(exhausted);
+    tlmWrite_AllocFailures(m_allocFailures.load(std::memory_order_relaxed));
+    tlmWrite_CacheHits(hits);
+  }
+
+} // end namespace FlightComputer
@@ -0,0 +1,140 @@
+#ifndef BufferPool_HPP
+#define BufferPool_HPP
+
+#include "FlightComputer/BufferPool/BufferPoolComponentAc.hpp"
+#include "FlightComputer/BufferPool/BufferPool_ClassCountsArrayAc.hpp"
+#include "FlightComputer/BufferPool/FreeList.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+#include "Fw/Types/MemAllocator.hpp"
+#include <atomic>
+
+namespace FlightComputer {
+  class BufferPool :
+  public BufferPoolComponentBase
+  {
+
+    public:
+
+        static const U32 MAX_SIZE_CLASSES = BufferPool_ClassCounts::SIZE;
+        //! Free buffers a thread keeps per size class before returns spill to the shared free list
+        static const U32 CACHE_DEPTH = 4;
+        //! Most thread caches a pool can be set up with
+        static const U32 MAX_THREAD_CACHES = 16;
+        //! Buffers per size class, bounded by the index bits of the buffer context
+        static const U32 MAX_BUFFERS_PER_CLASS = 1U << 14;
+
+        //! One size class: numBuffers buffers of bufferSize bytes
+        struct SizeClass {
+            U32 bufferSize;
+            U32 numBuffers;
+        };
+
+        // ----------------------------------------------------------------------
+        // Construction, initialization, and destruction
+        // ----------------------------------------------------------------------
+
+        //! Construct object BufferPool
+        //!
+        BufferPool(
+            const char *const compName /*!< The component name*/
+        );
+
+        //! Initialize object BufferPool
+        //!
+        void init(
+            const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+        );
+
+        //! Allocate and pre-fault the pool storage
+        //!
+        //! Classes must be given in increasing bufferSize order. The first numThreadCaches threads to get or return a
+        //! buffer each claim a cache and any further threads go straight to the free lists. Up to
+        //! numThreadCaches * CACHE_DEPTH buffers of a class can sit in caches, so numBuffers should leave that much
+        //! headroom over the expected peak.
+        //!
+        void setup(
+            const U16 poolId, /*!< Identifies this pool in the context of the buffers it hands out*/
+            const NATIVE_UINT_TYPE allocatorId, /*!< Identifier passed to the allocator*/
+            Fw::MemAllocator& allocator, /*!< Allocator for the pool storage*/
+            const SizeClass classes[], /*!< Size classes, smallest first*/
+            const U32 numClasses, /*!< Number of entries in classes*/
+            const U32 numThreadCaches /*!< Threads that get a cache, at most MAX_THREAD_CACHES*/
+        );
+
+        //! Return the pool storage to the allocator. No buffer may be in use.
+        //!
+        void cleanup();
+
+        //! Destroy object BufferPool
+        //!
+        ~BufferPool();
+
+    PRIVATE:
+
+        //! Storage and accounting for one size class
+        struct Class {
+            U8* storage;
+            U32 bufferSize; //!< Usable bytes per buffer
+            U32 stride; //!< bufferSize rounded up to a cache line
+            U32 numBuffers;
+            FreeList freeList;
+            std::atomic<U8>* allocated; //!< Per buffer, set while the buffer is handed out
+            std::atomic<U32> inUse;
+            std::atomic<U32> highWater;
+            std::atomic<U32> exhausted;
+        };
+
+        //! Free buffers held by one thread; only that thread touches the entries
+        struct alignas(64) ThreadCache {
+            U32 counts[MAX_SIZE_CLASSES];
+            U32 entries[MAX_SIZE_CLASSES][CACHE_DEPTH];
+            std::atomic<U32> hits; //!< Written by the owner, read by schedIn
+        };
+
+        //! The calling thread's cache, claimed on first use; nullptr once every cache is taken
+        ThreadCache* threadCache();
+
+        //! Take a free buffer index from class cls, or FreeList::EMPTY
+        U32 take(ThreadCache* cache, const U32 cls);
+
+        //! Give a buffer index of class cls back
+        void give(ThreadCache* cache, const U32 cls, const U32 index);
+
+        //! Handler implementation for bufferSendIn
+        //!
+        void bufferSendIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            Fw::Buffer& fwBuffer /*!< The buffer*/
+        );
+
+        //! Handler implementation for bufferGetCallee
+        //!
+        Fw::Buffer bufferGetCallee_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            U32 size /*!< The requested size*/
+        );
+
+        //! Handler implementation for schedIn
+        //!
+        void schedIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            NATIVE_UINT_TYPE context /*!< The call order*/
+        );
+
+        U16 m_poolId;
+        NATIVE_UINT_TYPE m_allocatorId;
+        Fw::MemAllocator* m_allocator;
+        void* m_memory;
+        U32 m_numClasses;
+        Class m_classes[MAX_SIZE_CLASSES];
+
+        ThreadCache m_caches[MAX_THREAD_CACHES];
+        U32 m_numThreadCaches;
+        std::atomic<U32> m_cachesClaimed;
+
+        std::atomic<U32> m_allocFailures;
+
+    };
+
+} // end namespace FlightComputer
+#endif
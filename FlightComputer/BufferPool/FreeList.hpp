@@ -0,0 +1,69 @@
+#ifndef BUFFERPOOL_FREELIST_H_
+#define BUFFERPOOL_FREELIST_H_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <atomic>
+
+namespace FlightComputer {
+
+/**
+ * \brief lock-free LIFO of buffer indices (a Treiber stack)
+ *
+ * Entries are indices into caller owned link storage rather than pointers, so the head fits in 64 bits together with
+ * a modification tag. The tag changes on every successful push or pop, which is what keeps a pop that was preempted
+ * between reading the head and swapping it from resurrecting an index that was popped and pushed back meanwhile (ABA).
+ * The link storage must outlive the list; links of popped entries are read by racing pops but never dereferenced.
+ */
+class FreeList {
+  public:
+    static const U32 EMPTY = 0xFFFFFFFF;
+
+    FreeList() : m_links(nullptr), m_head(pack(0, EMPTY)) {}
+
+    //! Attach link storage of at least count entries and fill the list with indices 0..count-1
+    void setup(std::atomic<U32>* links, const U32 count) {
+        m_links = links;
+        for (U32 index = 0; index < count; index++) {
+            m_links[index].store((index + 1 < count) ? index + 1 : EMPTY, std::memory_order_relaxed);
+        }
+        m_head.store(pack(0, (count > 0) ? 0 : EMPTY), std::memory_order_release);
+    }
+
+    //! Pop an index, or EMPTY if there is none
+    U32 pop() {
+        U64 head = m_head.load(std::memory_order_acquire);
+        while (true) {
+            const U32 index = indexOf(head);
+            if (index == EMPTY) {
+                return EMPTY;
+            }
+            const U32 next = m_links[index].load(std::memory_order_relaxed);
+            if (m_head.compare_exchange_weak(head, pack(tagOf(head) + 1, next), std::memory_order_acquire,
+                                             std::memory_order_acquire)) {
+                return index;
+            }
+        }
+    }
+
+    //! Push an index that is not currently in the list
+    void push(const U32 index) {
+        U64 head = m_head.load(std::memory_order_relaxed);
+        do {
+            m_links[index].store(indexOf(head), std::memory_order_relaxed);
+        } while (!m_head.compare_exchange_weak(head, pack(tagOf(head) + 1, index), std::memory_order_release,
+                                               std::memory_order_relaxed));
+    }
+
+  private:
+    static U64 pack(const U32 tag, const U32 index) { return (static_cast<U64>(tag) << 32) | index; }
+    static U32 tagOf(const U64 head) { return static_cast<U32>(head >> 32); }
+    static U32 indexOf(const U64 head) { return static_cast<U32>(head); }
+
+    std::atomic<U32>* m_links;
+    // Own cache line: every get and return that misses the thread caches swaps this word
+    alignas(64) std::atomic<U64> m_head;
+};
+
+}  // namespace FlightComputer
+
+#endif  // BUFFERPOOL_FREELIST_H_
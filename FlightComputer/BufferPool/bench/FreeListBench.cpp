@@ -0,0 +1,146 @@
+// ======================================================================
+// \title  FreeListBench.cpp
+// \brief  contended get/return cost of the pool's free list
+//
+// Every thread repeatedly takes a small burst of buffers and returns
+// them, the pattern of the comm, framer and frame accumulator tasks.
+// The same workload runs against a mutex guarded stack (the shape of
+// Svc.BufferManager's locked bins), the lock-free free list, and the
+// free list fronted by a per-thread cache as BufferPool uses it.
+//
+// Usage: ./FreeListBench [threads] [rounds per thread]
+// ======================================================================
+
+#include "FlightComputer/BufferPool/FreeList.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace FlightComputer;
+
+namespace {
+    const U32 BUFFERS = 64;
+    const U32 BURST = 3;
+    const U32 CACHE_DEPTH = 4;
+
+    class LockedStack {
+      public:
+        LockedStack() : m_count(BUFFERS) {
+            for (U32 i = 0; i < BUFFERS; i++) {
+                m_entries[i] = i;
+            }
+        }
+        U32 pop() {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return (m_count > 0) ? m_entries[--m_count] : FreeList::EMPTY;
+        }
+        void push(const U32 index) {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_entries[m_count++] = index;
+        }
+
+      private:
+        std::mutex m_lock;
+        U32 m_entries[BUFFERS];
+        U32 m_count;
+    };
+
+    // Mirrors BufferPool's take/give around a free list
+    template <typename List>
+    class Cached {
+      public:
+        explicit Cached(List& list) : m_list(list), m_count(0) {}
+        U32 pop() { return (m_count > 0) ? m_entries[--m_count] : m_list.pop(); }
+        void push(const U32 index) {
+            if (m_count < CACHE_DEPTH) {
+                m_entries[m_count++] = index;
+            } else {
+                m_list.push(index);
+            }
+        }
+
+      private:
+        List& m_list;
+        U32 m_entries[CACHE_DEPTH];
+        U32 m_count;
+    };
+
+    template <typename Make>
+    double nsPerOp(const U32 threads, const unsigned long rounds, Make make, unsigned long& failures) {
+        std::vector<std::thread> workers;
+        std::vector<unsigned long> failed(threads, 0);
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (U32 t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                auto list = make();
+                U32 held[BURST];
+                for (unsigned long r = 0; r < rounds; r++) {
+                    for (U32 b = 0; b < BURST; b++) {
+                        held[b] = list.pop();
+                    }
+                    for (U32 b = 0; b < BURST; b++) {
+                        if (held[b] == FreeList::EMPTY) {
+                            failed[t]++;
+                        } else {
+                            list.push(held[b]);
+                        }
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        failures = 0;
+        for (U32 t = 0; t < threads; t++) {
+            failures += failed[t];
+        }
+        // Wall time per get+return pair across all threads
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+               static_cast<double>(rounds * BURST * threads);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const U32 threads = (argc > 1) ? static_cast<U32>(std::strtoul(argv[1], nullptr, 10)) : 4U;
+    const unsigned long rounds = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000000UL;
+    if (threads == 0 || rounds == 0) {
+        (void) fprintf(stderr, "Usage: %s [threads] [rounds per thread]\n", argv[0]);
+        return 1;
+    }
+
+    LockedStack locked;
+    std::atomic<U32> links[BUFFERS];
+    FreeList freeList;
+    freeList.setup(links, BUFFERS);
+
+    struct LockedRef {
+        LockedStack& stack;
+        U32 pop() { return stack.pop(); }
+        void push(const U32 index) { stack.push(index); }
+    };
+    struct FreeListRef {
+        FreeList& list;
+        U32 pop() { return list.pop(); }
+        void push(const U32 index) { list.push(index); }
+    };
+
+    unsigned long lockedFailures = 0;
+    unsigned long freeFailures = 0;
+    unsigned long cachedFailures = 0;
+    const double lockedNs = nsPerOp(threads, rounds, [&]() { return LockedRef{locked}; }, lockedFailures);
+    const double freeNs = nsPerOp(threads, rounds, [&]() { return FreeListRef{freeList}; }, freeFailures);
+    const double cachedNs = nsPerOp(threads, rounds, [&]() { return Cached<FreeList>(freeList); }, cachedFailures);
+
+    (void) printf("%u threads x %lu rounds of %u gets then %u returns, %u buffers\n", threads, rounds, BURST, BURST,
+                  BUFFERS);
+    (void) printf("  mutex stack:          %8.1f ns/pair (%lu failed gets)\n", lockedNs, lockedFailures);
+    (void) printf("  lock-free free list:  %8.1f ns/pair (%lu failed gets)\n", freeNs, freeFailures);
+    (void) printf("  free list + cache:    %8.1f ns/pair (%lu failed gets)\n", cachedNs, cachedFailures);
+    return 0;
+}
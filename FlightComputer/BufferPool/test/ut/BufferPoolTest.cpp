@@ -0,0 +1,244 @@
+// ======================================================================
+// \title  BufferPoolTest.cpp
+// \brief  multithreaded conservation tests of the free list and the pool
+//
+// Several threads take and return buffers as fast as they can. Each
+// index or buffer is marked as owned while a thread holds it, so a
+// buffer handed to two threads at once fails the test, and once the
+// threads are done every buffer must be accounted for exactly once.
+// ======================================================================
+
+#include "FlightComputer/BufferPool/BufferPool.hpp"
+#include "FlightComputer/BufferPool/FreeList.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+#include "Fw/Types/MallocAllocator.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace FlightComputer;
+
+namespace {
+    const U32 THREADS = 8;
+    const U32 ROUNDS = 200000;
+    //! Most buffers a thread holds at once
+    const U32 HOLD = 5;
+
+    //! Run body(thread) on THREADS threads and wait for all of them
+    template <typename Body>
+    void runThreads(Body body) {
+        std::vector<std::thread> threads;
+        for (U32 t = 0; t < THREADS; t++) {
+            threads.emplace_back(body, t);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+TEST(FreeList, ConcurrentPopPushConservesIndices) {
+    const U32 COUNT = 32;
+    std::atomic<U32> links[COUNT];
+    FreeList list;
+    list.setup(links, COUNT);
+
+    std::atomic<U8> owned[COUNT];
+    for (U32 index = 0; index < COUNT; index++) {
+        owned[index].store(0);
+    }
+    std::atomic<U32> doubleOwned(0);
+
+    runThreads([&](const U32 thread) {
+        std::mt19937 rng(thread);
+        U32 held[HOLD];
+        U32 count = 0;
+        for (U32 round = 0; round < ROUNDS; round++) {
+            if (count < HOLD && (count == 0 || rng() % 2 == 0)) {
+                const U32 index = list.pop();
+                if (index == FreeList::EMPTY) {
+                    continue;
+                }
+                if (owned[index].exchange(1) != 0) {
+                    doubleOwned.fetch_add(1);
+                }
+                held[count++] = index;
+            } else {
+                const U32 index = held[--count];
+                owned[index].store(0);
+                list.push(index);
+            }
+        }
+        while (count > 0) {
+            const U32 index = held[--count];
+            owned[index].store(0);
+            list.push(index);
+        }
+    });
+
+    EXPECT_EQ(doubleOwned.load(), 0U);
+    bool seen[COUNT] = {};
+    U32 popped = 0;
+    for (U32 index = list.pop(); index != FreeList::EMPTY; index = list.pop()) {
+        ASSERT_LT(index, COUNT);
+        EXPECT_FALSE(seen[index]) << "index " << index << " listed twice";
+        seen[index] = true;
+        popped++;
+    }
+    EXPECT_EQ(popped, COUNT);
+}
+
+TEST(BufferPool, ConcurrentGetReturnConservesBuffers) {
+    // Half the threads get a cache and the rest work straight off the free lists
+    const U32 caches = THREADS / 2;
+    // Each class covers what the threads hold at once plus what the caches may keep, the rule setup() documents
+    const U32 perClass = THREADS * HOLD + caches * BufferPool::CACHE_DEPTH;
+    const BufferPool::SizeClass classes[] = {{128, perClass}, {1024, perClass}};
+    const U32 numClasses = FW_NUM_ARRAY_ELEMENTS(classes);
+    Fw::MallocAllocator allocator;
+    BufferPool pool("pool");
+    pool.init();
+    pool.setup(7, 0, allocator, classes, numClasses, caches);
+
+    std::atomic<U32> corrupted(0);
+    std::atomic<U32> failed(0);
+
+    runThreads([&](const U32 thread) {
+        std::mt19937 rng(thread);
+        Fw::Buffer held[HOLD];
+        U32 count = 0;
+        const U8 mark = static_cast<U8>(thread + 1);
+        for (U32 round = 0; round < ROUNDS / 4; round++) {
+            if (count < HOLD && (count == 0 || rng() % 2 == 0)) {
+                // Mostly small requests, which fall through to the large class once the small one runs dry
+                const U32 size = (rng() % 4 == 0) ? 1000 : 100;
+                Fw::Buffer buffer = pool.bufferGetCallee_handler(0, size);
+                if (buffer.getData() == nullptr) {
+                    failed.fetch_add(1);
+                    continue;
+                }
+                // A buffer handed out twice is overwritten by the other holder
+                (void) memset(buffer.getData(), mark, buffer.getSize());
+                held[count++] = buffer;
+            } else {
+                Fw::Buffer& buffer = held[--count];
+                for (U32 b = 0; b < buffer.getSize(); b++) {
+                    if (buffer.getData()[b] != mark) {
+                        corrupted.fetch_add(1);
+                        break;
+                    }
+                }
+                pool.bufferSendIn_handler(0, buffer);
+            }
+        }
+        while (count > 0) {
+            pool.bufferSendIn_handler(0, held[--count]);
+        }
+    });
+
+    EXPECT_EQ(corrupted.load(), 0U);
+    // The pool has the documented headroom, so only a leak could make requests fail
+    EXPECT_EQ(failed.load(), 0U);
+
+    // Every buffer is now free exactly once, in a free list or a thread cache
+    for (U32 cls = 0; cls < numClasses; cls++) {
+        EXPECT_EQ(pool.m_classes[cls].inUse.load(), 0U);
+        std::vector<U32> free;
+        for (U32 index = pool.m_classes[cls].freeList.pop(); index != FreeList::EMPTY;
+             index = pool.m_classes[cls].freeList.pop()) {
+            free.push_back(index);
+        }
+        for (U32 c = 0; c < BufferPool::MAX_THREAD_CACHES; c++) {
+            for (U32 e = 0; e < pool.m_caches[c].counts[cls]; e++) {
+                free.push_back(pool.m_caches[c].entries[cls][e]);
+            }
+        }
+        EXPECT_EQ(free.size(), classes[cls].numBuffers);
+        std::vector<bool> seen(classes[cls].numBuffers, false);
+        for (const U32 index : free) {
+            ASSERT_LT(index, classes[cls].numBuffers);
+            EXPECT_FALSE(seen[index]) << "class " << cls << " index " << index << " free twice";
+            seen[index] = true;
+        }
+    }
+    pool.cleanup();
+}
+
+TEST(BufferPool, IgnoresForeignBuffers) {
+    const BufferPool::SizeClass classes[] = {{128, 4}};
+    Fw::MallocAllocator allocator;
+    BufferPool pool("pool");
+    pool.init();
+    pool.setup(7, 0, allocator, classes, 1, 1);
+
+    Fw::Buffer buffer = pool.bufferGetCallee_handler(0, 64);
+    ASSERT_NE(buffer.getData(), nullptr);
+    ASSERT_EQ(pool.m_classes[0].inUse.load(), 1U);
+
+    // Another pool's id, an index past the class, and a pointer outside the buffer its context names
+    U8 other[128];
+    Fw::Buffer foreign(buffer.getData(), buffer.getSize(), buffer.getContext() ^ (1U << 16));
+    pool.bufferSendIn_handler(0, foreign);
+    Fw::Buffer badIndex(buffer.getData(), buffer.getSize(), buffer.getContext() | 0x3FFF);
+    pool.bufferSendIn_handler(0, badIndex);
+    Fw::Buffer badData(other, sizeof(other), buffer.getContext());
+    pool.bufferSendIn_handler(0, badData);
+    EXPECT_EQ(pool.m_classes[0].inUse.load(), 1U);
+
+    pool.bufferSendIn_handler(0, buffer);
+    EXPECT_EQ(pool.m_classes[0].inUse.load(), 0U);
+    pool.cleanup();
+}
+
+TEST(BufferPool, IgnoresDoubleReturns) {
+    const U32 count = 4;
+    const BufferPool::SizeClass classes[] = {{128, count}};
+    Fw::MallocAllocator allocator;
+    BufferPool pool("pool");
+    pool.init();
+    pool.setup(7, 0, allocator, classes, 1, 1);
+
+    Fw::Buffer buffer = pool.bufferGetCallee_handler(0, 64);
+    ASSERT_NE(buffer.getData(), nullptr);
+    Fw::Buffer copy = buffer;
+    pool.bufferSendIn_handler(0, buffer);
+    pool.bufferSendIn_handler(0, copy);
+    EXPECT_EQ(pool.m_classes[0].inUse.load(), 0U);
+
+    // Were the index listed twice, two of these would share memory
+    Fw::Buffer held[count];
+    for (U32 b = 0; b < count; b++) {
+        held[b] = pool.bufferGetCallee_handler(0, 64);
+        ASSERT_NE(held[b].getData(), nullptr);
+        for (U32 other = 0; other < b; other++) {
+            EXPECT_NE(held[b].getData(), held[other].getData()) << "buffer handed out twice";
+        }
+    }
+    EXPECT_EQ(pool.bufferGetCallee_handler(0, 64).getData(), nullptr);
+    EXPECT_EQ(pool.m_classes[0].inUse.load(), count);
+
+    // A return racing another return of the same buffer frees it once
+    for (U32 b = 0; b < count; b++) {
+        Fw::Buffer first = held[b];
+        Fw::Buffer second = held[b];
+        std::thread racer([&]() { pool.bufferSendIn_handler(0, first); });
+        pool.bufferSendIn_handler(0, second);
+        racer.join();
+    }
+    EXPECT_EQ(pool.m_classes[0].inUse.load(), 0U);
+    U32 freeCount = 0;
+    for (U32 b = 0; b < count + 1; b++) {
+        freeCount += (pool.bufferGetCallee_handler(0, 64).getData() != nullptr) ? 1 : 0;
+    }
+    EXPECT_EQ(freeCount, count);
+    pool.cleanup();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
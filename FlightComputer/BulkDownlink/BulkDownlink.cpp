@@ -0,0 +1,392 @@
+// ======================================================================
+// \title  BulkDownlink.cpp
+// \brief  cpp file for BulkDownlink component implementation class
+// ======================================================================
+
+#include <FlightComputer/BulkDownlink/BulkDownlink.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <limits>
+
+namespace FlightComputer {
+
+  namespace {
+    // The bucket holds at most this fraction of a second of budget so an idle period cannot turn into a burst
+    const U32 MAX_BURST_DIVISOR = 20;
+    // Longest gap credited by one refill; the bucket is full long before this
+    const U64 MAX_REFILL_US = 1000000;
+  }
+
+  BulkDownlink ::
+    BulkDownlink(
+        const char *const compName
+    ) : BulkDownlinkComponentBase(compName),
+        m_chunkSize(0),
+        m_bytesPerSecond(0),
+        m_state(IDLE),
+        m_fd(-1),
+        m_fileSize(0),
+        m_offset(0),
+        m_sequence(0),
+        m_opCode(0),
+        m_cmdSeq(0),
+        m_tokens(0),
+        m_filesSent(0),
+        m_bytesSent(0),
+        m_windowBytes(0),
+        m_pacePending(false),
+        m_skippedTicks(0)
+  {
+    for (U32 slot = 0; slot < MAX_IN_FLIGHT; slot++) {
+      m_slotUsed[slot] = false;
+    }
+  }
+
+  BulkDownlink ::~BulkDownlink() {
+    finishTransfer();
+  }
+
+  void BulkDownlink ::
+    init(
+        const NATIVE_INT_TYPE queueDepth,
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    BulkDownlinkComponentBase::init(queueDepth, instance);
+  }
+
+  void BulkDownlink ::configure(const U16 chunkSize, const U32 bytesPerSecond) {
+    FW_ASSERT(chunkSize > 0 && chunkSize <= MAX_CHUNK_SIZE, chunkSize);
+    FW_ASSERT(bytesPerSecond > 0);
+    m_chunkSize = chunkSize;
+    m_bytesPerSecond = bytesPerSecond;
+    m_throughput.setbudgetBytesPerSecond(bytesPerSecond);
+  }
+
+  U64 BulkDownlink ::elapsedUs(const Fw::Time& start, const Fw::Time& end) {
+    if (start.getTimeBase() != end.getTimeBase() || end <= start) {
+      return 0;
+    }
+    const Fw::Time diff = Fw::Time::sub(end, start);
+    return static_cast<U64>(diff.getSeconds()) * 1000000 + diff.getUSeconds();
+  }
+
+  void BulkDownlink ::refill(const Fw::Time& now) {
+    U64 us = elapsedUs(m_lastTick, now);
+    m_lastTick = now;
+    if (us > MAX_REFILL_US) {
+      us = MAX_REFILL_US;
+    }
+
+    U32 cap = m_bytesPerSecond / MAX_BURST_DIVISOR;
+    if (cap < m_chunkSize) {
+      cap = m_chunkSize;
+    }
+    const U64 accrued = static_cast<U64>(m_bytesPerSecond) * us / 1000000;
+    const U64 tokens = m_tokens + accrued;
+    m_tokens = (tokens > cap) ? cap : static_cast<U32>(tokens);
+  }
+
+  bool BulkDownlink ::sendPacket(const Fw::FilePacket& packet) {
+    U32 slot = MAX_IN_FLIGHT;
+    m_slotLock.lock();
+    for (U32 i = 0; i < MAX_IN_FLIGHT; i++) {
+      if (!m_slotUsed[i]) {
+        slot = i;
+        break;
+      }
+    }
+    m_slotLock.unLock();
+    if (slot == MAX_IN_FLIGHT) {
+      m_backpressure.setwindowFullTicks(m_backpressure.getwindowFullTicks() + 1);
+      return false;
+    }
+
+    const U32 size = packet.bufferSize();
+    Fw::Buffer buffer = bufferGet_out(0, size);
+    if (buffer.getData() == nullptr || buffer.getSize() < size) {
+      if (buffer.getData() != nullptr) {
+        bufferDeallocate_out(0, buffer);
+      }
+      m_backpressure.setallocFailures(m_backpressure.getallocFailures() + 1);
+      return false;
+    }
+
+    m_slotLock.lock();
+    m_slots[slot] = buffer;
+    m_slotUsed[slot] = true;
+    m_slotLock.unLock();
+
+    // Serialization copies the payload into the packet buffer
+    Fw::Buffer out = buffer;
+    const Fw::SerializeStatus status = packet.toBuffer(out);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    out.setSize(size);
+    bufferSendOut_out(0, out);
+    return true;
+  }
+
+  void BulkDownlink ::finishTransfer() {
+    if (m_fd >= 0) {
+      (void) close(m_fd);
+      m_fd = -1;
+    }
+    m_state = IDLE;
+  }
+
+  void BulkDownlink ::sendCancel() {
+    // Best effort: tell the ground to drop the partial file, skipped if there is no buffer for it right now
+    Fw::FilePacket::CancelPacket cancelPacket;
+    cancelPacket.initialize(m_sequence);
+    Fw::FilePacket packet;
+    packet.fromCancelPacket(cancelPacket);
+    (void) sendPacket(packet);
+  }
+
+  bool BulkDownlink ::readChunk(const U16 size) {
+    U32 done = 0;
+    while (done < size) {
+      const ssize_t got = pread(m_fd, m_chunk + done, size - done, static_cast<off_t>(m_offset) + done);
+      if (got < 0 && errno == EINTR) {
+        continue;
+      }
+      if (got <= 0) {
+        // A file cut short since it was opened ends the transfer like a read error
+        log_WARNING_HI_BulkReadFailed(m_sourceName, m_offset + done, (got < 0) ? errno : 0);
+        return false;
+      }
+      done += static_cast<U32>(got);
+    }
+    return true;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void BulkDownlink ::
+    Run_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    if (m_pacePending.exchange(true)) {
+      m_skippedTicks.fetch_add(1);
+      return;
+    }
+    pace_internalInterfaceInvoke();
+  }
+
+  // ----------------------------------------------------------------------
+  // Internal interface handler implementations
+  // ----------------------------------------------------------------------
+
+  void BulkDownlink ::pace_internalInterfaceHandler() {
+    // Cleared first: a tick arriving while packets go out queues the next pass
+    m_pacePending.store(false);
+
+    const Fw::Time now = getTime();
+    if (m_lastTick.getTimeBase() != now.getTimeBase()) {
+      // First tick: start accruing budget and measuring throughput from here
+      m_lastTick = now;
+      m_windowStart = now;
+    }
+    refill(now);
+
+    bool budgetLimited = false;
+    while (m_state != IDLE) {
+      if (m_state == SENDING_START) {
+        Fw::FilePacket::StartPacket startPacket;
+        startPacket.initialize(m_fileSize, m_sourceName.toChar(), m_destName.toChar());
+        Fw::FilePacket packet;
+        packet.fromStartPacket(startPacket);
+        if (!sendPacket(packet)) {
+          break;
+        }
+        m_sequence++;
+        m_state = SENDING_DATA;
+      } else if (m_state == SENDING_DATA) {
+        if (m_offset >= m_fileSize) {
+          m_state = SENDING_END;
+          continue;
+        }
+        const U32 remaining = m_fileSize - m_offset;
+        const U16 payload = (remaining < m_chunkSize) ? static_cast<U16>(remaining) : m_chunkSize;
+        if (m_tokens < payload) {
+          budgetLimited = true;
+          break;
+        }
+        // Read again on every attempt: a packet refused for backpressure leaves the chunk unsent
+        if (!readChunk(payload)) {
+          sendCancel();
+          cmdResponse_out(m_opCode, m_cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+          finishTransfer();
+          break;
+        }
+        Fw::FilePacket::DataPacket dataPacket;
+        dataPacket.initialize(m_sequence, m_offset, payload, m_chunk);
+        Fw::FilePacket packet;
+        packet.fromDataPacket(dataPacket);
+        if (!sendPacket(packet)) {
+          break;
+        }
+        m_checksum.update(m_chunk, m_offset, payload);
+        m_offset += payload;
+        m_sequence++;
+        m_tokens -= payload;
+        m_bytesSent += payload;
+        m_windowBytes += payload;
+      } else {
+        Fw::FilePacket::EndPacket endPacket;
+        endPacket.initialize(m_sequence, m_checksum);
+        Fw::FilePacket packet;
+        packet.fromEndPacket(endPacket);
+        if (!sendPacket(packet)) {
+          break;
+        }
+        m_filesSent++;
+        log_ACTIVITY_HI_BulkCompleted(m_sourceName, m_fileSize, elapsedUs(m_startTime, now) / 1000);
+        cmdResponse_out(m_opCode, m_cmdSeq, Fw::CmdResponse::OK);
+        finishTransfer();
+      }
+    }
+    if (budgetLimited) {
+      m_backpressure.setbudgetLimitedTicks(m_backpressure.getbudgetLimitedTicks() + 1);
+    }
+
+    // Telemetry once per second keeps the channelizer load independent of the tick rate
+    const U64 windowUs = elapsedUs(m_windowStart, now);
+    if (windowUs >= 1000000) {
+      m_throughput.setbytesSent(m_bytesSent);
+      m_throughput.setbytesPerSecond(static_cast<U32>(static_cast<U64>(m_windowBytes) * 1000000 / windowUs));
+      m_windowBytes = 0;
+      m_windowStart = now;
+      tlmWrite_Throughput(m_throughput);
+      m_backpressure.setskippedTicks(m_skippedTicks.load());
+      tlmWrite_Backpressure(m_backpressure);
+      tlmWrite_FilesSent(m_filesSent);
+    }
+  }
+
+  void BulkDownlink ::
+    bufferReturn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    m_slotLock.lock();
+    for (U32 slot = 0; slot < MAX_IN_FLIGHT; slot++) {
+      if (m_slotUsed[slot] && m_slots[slot].getData() == fwBuffer.getData()) {
+        // Return the buffer as it was allocated; the framer may have changed its size
+        Fw::Buffer original = m_slots[slot];
+        m_slotUsed[slot] = false;
+        m_slotLock.unLock();
+        bufferDeallocate_out(0, original);
+        return;
+      }
+    }
+    m_slotLock.unLock();
+
+    // Not one of ours, e.g. a Svc.FileDownlink packet sharing the framer
+    forwardReturn_out(0, fwBuffer);
+  }
+
+  // ----------------------------------------------------------------------
+  // Command handler implementations
+  // ----------------------------------------------------------------------
+
+  void BulkDownlink ::
+    BULK_SEND_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& sourceFileName,
+        const Fw::CmdStringArg& destFileName
+    )
+  {
+    if (m_state != IDLE) {
+      log_WARNING_LO_BulkBusy();
+      cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+      return;
+    }
+
+    const int fd = open(sourceFileName.toChar(), O_RDONLY);
+    if (fd < 0) {
+      log_WARNING_HI_BulkOpenFailed(sourceFileName, errno);
+      cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    struct stat info;
+    I32 error = 0;
+    if (fstat(fd, &info) != 0) {
+      error = errno;
+    } else if (info.st_size > std::numeric_limits<U32>::max()) {
+      // File packets carry 32 bit offsets
+      error = EFBIG;
+    }
+    if (error != 0) {
+      (void) close(fd);
+      log_WARNING_HI_BulkOpenFailed(sourceFileName, error);
+      cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+
+    // The size is fixed here: bytes appended later are not sent, and a file truncated below it fails the transfer. A
+    // file rotated away keeps being read through this descriptor.
+    m_fileSize = static_cast<U32>(info.st_size);
+    m_fd = fd;
+    // Read-ahead for the front-to-back walk
+    (void) posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    m_sourceName = sourceFileName;
+    m_destName = destFileName;
+    m_opCode = opCode;
+    m_cmdSeq = cmdSeq;
+    m_offset = 0;
+    m_sequence = 0;
+    m_checksum = CFDP::Checksum();
+    m_bytesSent = 0;
+    m_startTime = getTime();
+    m_state = SENDING_START;
+
+    log_ACTIVITY_HI_BulkStarted(sourceFileName, destFileName, m_fileSize);
+  }
+
+  void BulkDownlink ::
+    BULK_CANCEL_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    if (m_state != IDLE) {
+      sendCancel();
+
+      log_ACTIVITY_HI_BulkCanceled(m_sourceName, m_bytesSent);
+      cmdResponse_out(m_opCode, m_cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      finishTransfer();
+    }
+    cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void BulkDownlink ::
+    BULK_SET_RATE_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        U32 bytesPerSecond
+    )
+  {
+    // A zero budget would stall the transfer in progress and its command would never complete
+    if (bytesPerSecond == 0) {
+      cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+    m_bytesPerSecond = bytesPerSecond;
+    m_throughput.setbudgetBytesPerSecond(bytesPerSecond);
+    log_ACTIVITY_HI_RateChanged(bytesPerSecond);
+    cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+} // end namespace FlightComputer
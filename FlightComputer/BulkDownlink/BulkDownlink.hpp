@@ -0,0 +1,146 @@
+#ifndef BulkDownlink_HPP
+#define BulkDownlink_HPP
+
+#include "CFDP/Checksum/Checksum.hpp"
+#include "FlightComputer/BulkDownlink/BulkDownlinkComponentAc.hpp"
+#include "Fw/FilePacket/FilePacket.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+#include "Fw/Types/String.hpp"
+#include "Os/Mutex.hpp"
+
+#include <atomic>
+
+namespace FlightComputer {
+  class BulkDownlink :
+  public BulkDownlinkComponentBase
+  {
+
+    public:
+
+        //! Packet buffers that may be out at the framer at once
+        static const U32 MAX_IN_FLIGHT = 8;
+
+        //! Largest data packet payload, the size of the read buffer
+        static const U16 MAX_CHUNK_SIZE = 4096;
+
+        // ----------------------------------------------------------------------
+        // Construction, initialization, and destruction
+        // ----------------------------------------------------------------------
+
+        //! Construct object BulkDownlink
+        //!
+        BulkDownlink(
+            const char *const compName /*!< The component name*/
+        );
+
+        //! Initialize object BulkDownlink
+        //!
+        void init(
+            const NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
+            const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+        );
+
+        //! Set the data packet payload size and the initial byte budget
+        //!
+        void configure(
+            const U16 chunkSize, /*!< Payload bytes per data packet, at most MAX_CHUNK_SIZE*/
+            const U32 bytesPerSecond /*!< Initial payload byte budget, nonzero*/
+        );
+
+        //! Destroy object BulkDownlink
+        //!
+        ~BulkDownlink();
+
+    PRIVATE:
+
+        enum State {
+            IDLE,
+            SENDING_START,
+            SENDING_DATA,
+            SENDING_END,
+        };
+
+        // Configuration
+        U16 m_chunkSize;
+        U32 m_bytesPerSecond;
+
+        // Transfer in progress
+        State m_state;
+        int m_fd;
+        U32 m_fileSize;
+        U32 m_offset;
+        U32 m_sequence;
+        CFDP::Checksum m_checksum;
+        Fw::String m_sourceName;
+        Fw::String m_destName;
+        FwOpcodeType m_opCode;
+        U32 m_cmdSeq;
+        Fw::Time m_startTime;
+        U8 m_chunk[MAX_CHUNK_SIZE];
+
+        // Byte budget (token bucket)
+        U32 m_tokens;
+        Fw::Time m_lastTick;
+
+        // Statistics
+        U32 m_filesSent;
+        U32 m_bytesSent;
+        U32 m_windowBytes;
+        Fw::Time m_windowStart;
+        BulkDownlink_throughput m_throughput;
+        BulkDownlink_backpressure m_backpressure;
+
+        // Tick coalescing, shared with the rate group thread
+        std::atomic<bool> m_pacePending;
+        std::atomic<U32> m_skippedTicks;
+
+        // Buffers handed to the framer, kept to match returns and restore their allocated size
+        Os::Mutex m_slotLock;
+        Fw::Buffer m_slots[MAX_IN_FLIGHT];
+        bool m_slotUsed[MAX_IN_FLIGHT];
+
+        //! Add the budget accrued since the last tick
+        void refill(const Fw::Time& now);
+
+        //! Serialize and send one packet. Returns false, sending nothing, on backpressure.
+        bool sendPacket(const Fw::FilePacket& packet);
+
+        //! Read size bytes at the current offset into m_chunk. Returns false, with an event, on an error or short read.
+        bool readChunk(const U16 size);
+
+        //! Tell the ground to drop the partial file
+        void sendCancel();
+
+        //! Close the source file and go idle
+        void finishTransfer();
+
+        //! Microseconds from start to end, saturating at zero
+        static U64 elapsedUs(const Fw::Time& start, const Fw::Time& end);
+
+        //! Handler implementation for Run
+        //!
+        void Run_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            NATIVE_UINT_TYPE context /*!< The call order*/
+        );
+
+        //! Internal interface handler for pace
+        //!
+        void pace_internalInterfaceHandler();
+
+        //! Handler implementation for bufferReturn
+        //!
+        void bufferReturn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            Fw::Buffer& fwBuffer /*!< The returned buffer*/
+        );
+
+        void BULK_SEND_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, const Fw::CmdStringArg& sourceFileName,
+                                  const Fw::CmdStringArg& destFileName);
+        void BULK_CANCEL_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq);
+        void BULK_SET_RATE_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, U32 bytesPerSecond);
+
+    };
+
+} // end namespace FlightComputer
+#endif
@@ -0,0 +1,70 @@
+#ifndef COMMON_CRC32_H_
+#define COMMON_CRC32_H_
+
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace FlightComputer {
+
+/**
+ * \brief incremental CRC-32 (IEEE 802.3, as used by the F' framing protocol)
+ *
+ * Slicing-by-8: eight bytes per step through eight 256 entry tables instead of one byte per step through one table.
+ * The state can be fed any number of times, so a checksum can be carried across data that arrives in pieces.
+ */
+class Crc32 {
+  public:
+    Crc32() : m_state(0xFFFFFFFFU) {}
+
+    void reset() { m_state = 0xFFFFFFFFU; }
+
+    void update(const U8* data, U32 length) {
+        const Tables& t = tables();
+        U32 crc = m_state;
+        while (length >= 8) {
+            const U32 lo = crc ^ (static_cast<U32>(data[0]) | (static_cast<U32>(data[1]) << 8) |
+                                  (static_cast<U32>(data[2]) << 16) | (static_cast<U32>(data[3]) << 24));
+            crc = t.table[7][lo & 0xFF] ^ t.table[6][(lo >> 8) & 0xFF] ^ t.table[5][(lo >> 16) & 0xFF] ^
+                  t.table[4][lo >> 24] ^ t.table[3][data[4]] ^ t.table[2][data[5]] ^ t.table[1][data[6]] ^
+                  t.table[0][data[7]];
+            data += 8;
+            length -= 8;
+        }
+        while (length-- > 0) {
+            crc = t.table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+        }
+        m_state = crc;
+    }
+
+    U32 value() const { return m_state ^ 0xFFFFFFFFU; }
+
+  private:
+    struct Tables {
+        U32 table[8][256];
+
+        Tables() {
+            for (U32 i = 0; i < 256; i++) {
+                U32 crc = i;
+                for (U32 bit = 0; bit < 8; bit++) {
+                    crc = (crc & 1U) ? (crc >> 1) ^ 0xEDB88320U : crc >> 1;
+                }
+                table[0][i] = crc;
+            }
+            for (U32 i = 0; i < 256; i++) {
+                for (U32 slice = 1; slice < 8; slice++) {
+                    table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+
+    static const Tables& tables() {
+        static const Tables s_tables;
+        return s_tables;
+    }
+
+    U32 m_state;
+};
+
+}  // namespace FlightComputer
+
+#endif  // COMMON_CRC32_H_
@@ -0,0 +1,79 @@
+#ifndef COMMON_KALMANFILTER_H_
+#define COMMON_KALMANFILTER_H_
+
+#include "FlightComputer/Common/Matrix.hpp"
+
+namespace FlightComputer {
+
+/**
+ * \brief linear Kalman filter over fixed size matrices
+ *
+ * N: number of states, M: number of measurements, U: number of control inputs. The model matrices are public so the
+ * owner can set them up once (or adjust them between steps, e.g. when dt changes) without any accessor boilerplate.
+ * Neither step allocates; all intermediates are fixed size and live on the stack.
+ */
+template <typename T, std::size_t N, std::size_t M, std::size_t U>
+class KalmanFilter {
+  public:
+    typedef Matrix<T, N, 1> StateVec;
+    typedef Matrix<T, N, N> StateMat;
+    typedef Matrix<T, M, 1> MeasVec;
+    typedef Matrix<T, U, 1> CtrlVec;
+
+    KalmanFilter()
+        : F(StateMat::identity()),
+          B(Matrix<T, N, U>::zeros()),
+          Q(StateMat::zeros()),
+          H(Matrix<T, M, N>::zeros()),
+          R(Matrix<T, M, M>::identity()),
+          x(StateVec::zeros()),
+          P(StateMat::identity()) {}
+
+    //! Reset the state and covariance, leaving the model untouched
+    void reset(const StateVec& x0, const StateMat& P0) {
+        x = x0;
+        P = P0;
+    }
+
+    //! Time update: x = F x + B u, P = F P F' + Q
+    void predict(const CtrlVec& u) {
+        x = F * x + B * u;
+        P = F * P * F.transpose() + Q;
+    }
+
+    /**
+     * \brief measurement update
+     *
+     * \param z: measurement vector
+     * \param innovation: receives z - H x evaluated before the update
+     * \return false if the innovation covariance could not be inverted, in which case the state is unchanged
+     */
+    bool update(const MeasVec& z, MeasVec& innovation) {
+        const Matrix<T, N, M> PHt = P * H.transpose();
+        const Matrix<T, M, M> S = H * PHt + R;
+        Matrix<T, M, M> Sinv;
+        if (!invert(S, Sinv)) {
+            return false;
+        }
+        const Matrix<T, N, M> K = PHt * Sinv;
+
+        innovation = z - H * x;
+        x += K * innovation;
+        // Joseph form keeps P symmetric and positive definite in single precision
+        const StateMat IKH = StateMat::identity() - K * H;
+        P = IKH * P * IKH.transpose() + K * R * K.transpose();
+        return true;
+    }
+
+    Matrix<T, N, N> F;  //!< State transition
+    Matrix<T, N, U> B;  //!< Control input model
+    Matrix<T, N, N> Q;  //!< Process noise covariance
+    Matrix<T, M, N> H;  //!< Observation model
+    Matrix<T, M, M> R;  //!< Measurement noise covariance
+    StateVec x;         //!< State estimate
+    StateMat P;         //!< Estimate covariance
+};
+
+}  // namespace FlightComputer
+
+#endif  // COMMON_KALMANFILTER_H_
@@ -0,0 +1,231 @@
+#ifndef COMMON_MATRIX_H_
+#define COMMON_MATRIX_H_
+
+#include <cmath>
+#include <cstddef>
+
+namespace FlightComputer {
+
+template <typename T, std::size_t R, std::size_t C>
+struct Matrix;
+
+namespace MatrixDetail {
+
+//! Element indices of a matrix, expanded as a pack to build a whole matrix in one constant expression
+template <std::size_t... I>
+struct Indices {};
+
+template <std::size_t N, std::size_t... I>
+struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+
+template <std::size_t... I>
+struct MakeIndices<0, I...> {
+    typedef Indices<I...> Type;
+};
+
+template <typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr Matrix<T, R, C> filled(const T value, Indices<I...>) {
+    return {{(static_cast<void>(I), value)...}};
+}
+
+template <typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr Matrix<T, R, C> identity(Indices<I...>) {
+    return {{((I / C == I % C) ? T(1) : T(0))...}};
+}
+
+template <typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr Matrix<T, C, R> transpose(const Matrix<T, R, C>& in, Indices<I...>) {
+    return {{in.data[(I % R) * C + I / R]...}};
+}
+
+template <typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr Matrix<T, R, C> add(const Matrix<T, R, C>& lhs, const Matrix<T, R, C>& rhs, Indices<I...>) {
+    return {{T(lhs.data[I] + rhs.data[I])...}};
+}
+
+template <typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr Matrix<T, R, C> subtract(const Matrix<T, R, C>& lhs, const Matrix<T, R, C>& rhs, Indices<I...>) {
+    return {{T(lhs.data[I] - rhs.data[I])...}};
+}
+
+template <typename T, std::size_t R, std::size_t C, std::size_t... I>
+constexpr Matrix<T, R, C> scale(const Matrix<T, R, C>& lhs, const T factor, Indices<I...>) {
+    return {{T(lhs.data[I] * factor)...}};
+}
+
+//! Row r of lhs times column c of rhs, accumulated from k = 0 up like the loop form would
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr T dot(const Matrix<T, R, K>& lhs, const Matrix<T, K, C>& rhs, const std::size_t r, const std::size_t c,
+                const std::size_t k, const T sum) {
+    return (k == K) ? sum : dot(lhs, rhs, r, c, k + 1, T(sum + lhs(r, k) * rhs(k, c)));
+}
+
+template <typename T, std::size_t R, std::size_t K, std::size_t C, std::size_t... I>
+constexpr Matrix<T, R, C> multiply(const Matrix<T, R, K>& lhs, const Matrix<T, K, C>& rhs, Indices<I...>) {
+    return {{dot(lhs, rhs, I / C, I % C, 0, T(0))...}};
+}
+
+}  // namespace MatrixDetail
+
+/**
+ * \brief fixed size, row-major matrix
+ *
+ * Dimensions are template parameters so every matrix lives inline in its owner (stack, member or static storage) and
+ * no operation ever allocates. Storage is a single contiguous, 16-byte aligned array.
+ *
+ * The type is an aggregate, which allows constant matrices to be brace initialized at compile time:
+ *
+ *     constexpr Matrix<F32, 2, 2> I = {{1, 0, 0, 1}};
+ *
+ * The factories and the non-mutating operators are constexpr, so model matrices can equally be built from them at
+ * compile time. Being C++11 constexpr they are written as single expressions over the element indices; the compound
+ * assignments and fill() mutate and therefore stay plain loops.
+ */
+template <typename T, std::size_t R, std::size_t C>
+struct Matrix {
+    static_assert(R > 0 && C > 0, "Matrix dimensions must be non-zero");
+
+    typedef typename MatrixDetail::MakeIndices<R * C>::Type Elements;
+
+    alignas(16) T data[R * C];
+
+    static constexpr std::size_t rows() { return R; }
+    static constexpr std::size_t cols() { return C; }
+    static constexpr std::size_t size() { return R * C; }
+
+    constexpr const T& operator()(std::size_t r, std::size_t c) const { return data[r * C + c]; }
+    T& operator()(std::size_t r, std::size_t c) { return data[r * C + c]; }
+
+    //! Element access for column vectors
+    constexpr const T& operator[](std::size_t i) const { return data[i]; }
+    T& operator[](std::size_t i) { return data[i]; }
+
+    static constexpr Matrix zeros() { return filled(T(0)); }
+
+    //! Matrix with every element set to value
+    static constexpr Matrix filled(const T value) { return MatrixDetail::filled<T, R, C>(value, Elements()); }
+
+    static constexpr Matrix identity() {
+        static_assert(R == C, "identity is only defined for square matrices");
+        return MatrixDetail::identity<T, R, C>(Elements());
+    }
+
+    void fill(const T value) {
+        for (std::size_t i = 0; i < R * C; i++) {
+            data[i] = value;
+        }
+    }
+
+    constexpr Matrix<T, C, R> transpose() const { return MatrixDetail::transpose(*this, Elements()); }
+
+    Matrix& operator+=(const Matrix& rhs) {
+        for (std::size_t i = 0; i < R * C; i++) {
+            data[i] += rhs.data[i];
+        }
+        return *this;
+    }
+
+    Matrix& operator-=(const Matrix& rhs) {
+        for (std::size_t i = 0; i < R * C; i++) {
+            data[i] -= rhs.data[i];
+        }
+        return *this;
+    }
+
+    Matrix& operator*=(const T scale) {
+        for (std::size_t i = 0; i < R * C; i++) {
+            data[i] *= scale;
+        }
+        return *this;
+    }
+};
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr Matrix<T, R, C> operator+(const Matrix<T, R, C>& lhs, const Matrix<T, R, C>& rhs) {
+    return MatrixDetail::add(lhs, rhs, typename Matrix<T, R, C>::Elements());
+}
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr Matrix<T, R, C> operator-(const Matrix<T, R, C>& lhs, const Matrix<T, R, C>& rhs) {
+    return MatrixDetail::subtract(lhs, rhs, typename Matrix<T, R, C>::Elements());
+}
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr Matrix<T, R, C> operator*(const Matrix<T, R, C>& lhs, const T scale) {
+    return MatrixDetail::scale(lhs, scale, typename Matrix<T, R, C>::Elements());
+}
+
+//! Matrix product. Each element is summed in k order, the same order as the plain triple loop.
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr Matrix<T, R, C> operator*(const Matrix<T, R, K>& lhs, const Matrix<T, K, C>& rhs) {
+    return MatrixDetail::multiply(lhs, rhs, typename Matrix<T, R, C>::Elements());
+}
+
+/**
+ * \brief invert a square matrix with Gauss-Jordan elimination and partial pivoting
+ *
+ * Works in place on a copy of the input so no scratch memory is needed beyond the two N x N matrices on the stack.
+ *
+ * \param in: matrix to invert
+ * \param out: receives the inverse on success, unspecified otherwise
+ * \return false when the matrix is singular (pivot magnitude at or below epsilon)
+ */
+template <typename T, std::size_t N>
+bool invert(const Matrix<T, N, N>& in, Matrix<T, N, N>& out, const T epsilon = T(1e-12)) {
+    Matrix<T, N, N> a = in;
+    out = Matrix<T, N, N>::identity();
+
+    for (std::size_t col = 0; col < N; col++) {
+        std::size_t pivot = col;
+        for (std::size_t r = col + 1; r < N; r++) {
+            if (std::fabs(a(r, col)) > std::fabs(a(pivot, col))) {
+                pivot = r;
+            }
+        }
+        if (std::fabs(a(pivot, col)) <= epsilon) {
+            return false;
+        }
+        if (pivot != col) {
+            for (std::size_t c = 0; c < N; c++) {
+                T tmp = a(col, c);
+                a(col, c) = a(pivot, c);
+                a(pivot, c) = tmp;
+                tmp = out(col, c);
+                out(col, c) = out(pivot, c);
+                out(pivot, c) = tmp;
+            }
+        }
+
+        const T scale = T(1) / a(col, col);
+        for (std::size_t c = 0; c < N; c++) {
+            a(col, c) *= scale;
+            out(col, c) *= scale;
+        }
+
+        for (std::size_t r = 0; r < N; r++) {
+            if (r == col) {
+                continue;
+            }
+            const T factor = a(r, col);
+            for (std::size_t c = 0; c < N; c++) {
+                a(r, c) -= factor * a(col, c);
+                out(r, c) -= factor * out(col, c);
+            }
+        }
+    }
+    return true;
+}
+
+//! Closed form inverse for the 1x1 case, which is what scalar measurement updates hit
+template <typename T>
+bool invert(const Matrix<T, 1, 1>& in, Matrix<T, 1, 1>& out, const T epsilon = T(1e-12)) {
+    if (std::fabs(in.data[0]) <= epsilon) {
+        return false;
+    }
+    out.data[0] = T(1) / in.data[0];
+    return true;
+}
+
+}  // namespace FlightComputer
+
+#endif  // COMMON_MATRIX_H_
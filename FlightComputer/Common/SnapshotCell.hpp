@@ -0,0 +1,62 @@
+#ifndef COMMON_SNAPSHOTCELL_H_
+#define COMMON_SNAPSHOTCELL_H_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <atomic>
+
+namespace FlightComputer {
+
+/**
+ * \brief immutable snapshots of a value, published by writers and read by one thread with a single atomic load
+ *
+ * Snapshots live in a fixed set of slots and are never modified once published. The reader loads the current snapshot,
+ * uses it, and calls quiescent() once it holds no snapshot anymore (e.g. at the end of each handler). A replaced
+ * snapshot's slot is only rewritten after the reader has passed a quiescent point since the replacement, so a snapshot
+ * is never changed under the reader. Writers must be serialized by the caller. publish() fails when every other slot
+ * still waits for the reader; the caller should retry after the next quiescent point.
+ */
+template <typename T, U32 SLOTS>
+class SnapshotCell {
+  public:
+    SnapshotCell() : m_current(nullptr), m_quiescent(1) {
+        static_assert(SLOTS >= 2, "A snapshot cell needs a spare slot to publish into");
+        for (U32 slot = 0; slot < SLOTS; slot++) {
+            m_retiredAt[slot] = 0;
+        }
+    }
+
+    //! Current snapshot, or nullptr before the first publish. Reader only.
+    const T* load() const { return m_current.load(); }
+
+    //! Declare that the reader holds no snapshot. Reader only.
+    void quiescent() { m_quiescent.store(m_quiescent.load(std::memory_order_relaxed) + 1); }
+
+    //! Publish a copy of value as the current snapshot; false if no slot is free yet
+    bool publish(const T& value) {
+        const T* const current = m_current.load(std::memory_order_relaxed);
+        const U32 now = m_quiescent.load();
+        for (U32 slot = 0; slot < SLOTS; slot++) {
+            if (&m_slots[slot] == current || static_cast<I32>(now - m_retiredAt[slot]) <= 0) {
+                continue;
+            }
+            m_slots[slot] = value;
+            m_current.store(&m_slots[slot]);
+            if (current != nullptr) {
+                // The reader may hold the old snapshot until its next quiescent point
+                m_retiredAt[current - m_slots] = m_quiescent.load();
+            }
+            return true;
+        }
+        return false;
+    }
+
+  private:
+    T m_slots[SLOTS];
+    U32 m_retiredAt[SLOTS];  //!< Reader quiescent count when each slot was replaced, writer only
+    std::atomic<const T*> m_current;
+    std::atomic<U32> m_quiescent;
+};
+
+}  // namespace FlightComputer
+
+#endif  // COMMON_SNAPSHOTCELL_H_
@@ -0,0 +1,197 @@
+// ======================================================================
+// \title  DegradableRateGroup.cpp
+// \brief  cpp file for DegradableRateGroup component implementation class
+// ======================================================================
+
+#include <FlightComputer/DegradableRateGroup/DegradableRateGroup.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Svc/Cycle/TimerVal.hpp>
+
+namespace FlightComputer {
+
+  DegradableRateGroup ::
+    DegradableRateGroup(
+        const char *const compName
+    ) : DegradableRateGroupComponentBase(compName),
+        m_pendingCycles(0),
+        m_droppedCycles(0),
+        m_droppedCyclesReported(0),
+        m_degraded(false),
+        m_degradedCycles(0),
+        m_cycleSlips(0),
+        m_maxTimeUs(0),
+        m_deferredRuns(0),
+        m_shedTotal(0),
+        m_shedCounts()
+  {
+    for (NATIVE_INT_TYPE port = 0; port < CONNECTION_COUNT_MAX; port++) {
+      m_contexts[port] = 0;
+      m_classes[port] = DegradableRateGroup_MemberClass::CRITICAL;
+      m_owed[port] = false;
+      m_shedCounts[port] = 0;
+    }
+  }
+
+  DegradableRateGroup ::~DegradableRateGroup() {}
+
+  void DegradableRateGroup ::
+    init(
+        const NATIVE_INT_TYPE queueDepth,
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    DegradableRateGroupComponentBase::init(queueDepth, instance);
+  }
+
+  void DegradableRateGroup ::
+    configure(
+        const NATIVE_INT_TYPE contexts[],
+        const NATIVE_INT_TYPE numContexts,
+        const DegradableRateGroup_MemberClass::T classes[],
+        const NATIVE_INT_TYPE numClasses
+    )
+  {
+    FW_ASSERT(contexts != nullptr);
+    FW_ASSERT(classes != nullptr);
+    FW_ASSERT(numContexts <= CONNECTION_COUNT_MAX, numContexts);
+    FW_ASSERT(numClasses <= CONNECTION_COUNT_MAX, numClasses);
+
+    for (NATIVE_INT_TYPE port = 0; port < numContexts; port++) {
+      m_contexts[port] = static_cast<NATIVE_UINT_TYPE>(contexts[port]);
+    }
+    for (NATIVE_INT_TYPE port = 0; port < numClasses; port++) {
+      m_classes[port] = classes[port];
+    }
+
+    for (NATIVE_INT_TYPE port = numClasses; port < CONNECTION_COUNT_MAX; port++) {
+      FW_ASSERT(!isConnected_RateGroupMemberOut_OutputPort(port), port, numClasses);
+    }
+    FW_ASSERT(numClasses == 0 || isConnected_RateGroupMemberOut_OutputPort(numClasses - 1), numClasses);
+  }
+
+  void DegradableRateGroup ::runMember(const NATIVE_INT_TYPE port) {
+    if (isConnected_RateGroupMemberOut_OutputPort(port)) {
+      FC_TRACE_SCOPE("rategroup", "RateGroup.member");
+      FC_TRACE_INSTANT("rategroup", "RateGroup.dispatch", port, static_cast<I32>(m_contexts[port]));
+      RateGroupMemberOut_out(port, m_contexts[port]);
+    }
+  }
+
+  void DegradableRateGroup ::skipMember(const NATIVE_INT_TYPE port) {
+    if (!isConnected_RateGroupMemberOut_OutputPort(port)) {
+      return;
+    }
+    // The first skipped call is deferred, later ones while it is outstanding are shed
+    if (!m_owed[port]) {
+      m_owed[port] = true;
+      FC_TRACE_INSTANT("rategroup", "RateGroup.defer", port, 0);
+      return;
+    }
+    m_shedCounts[port]++;
+    m_shedTotal++;
+    FC_TRACE_INSTANT("rategroup", "RateGroup.shed", port, static_cast<I32>(m_shedCounts[port]));
+    log_WARNING_LO_MemberShed(static_cast<U32>(port), m_shedCounts[port]);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void DegradableRateGroup ::CycleIn_preMsgHook(const NATIVE_INT_TYPE portNum, Svc::TimerVal& cycleStart) {
+    FC_TRACE_ENQUEUE(m_queueFlow, "queue", "RateGroup");
+    m_pendingCycles.fetch_add(1);
+  }
+
+  void DegradableRateGroup ::CycleIn_overflowHook(const NATIVE_INT_TYPE portNum, Svc::TimerVal& cycleStart) {
+    // The pre-message hook already counted this cycle but it never made it into the queue
+    FC_TRACE_DROP(m_queueFlow, "queue", "RateGroup");
+    m_pendingCycles.fetch_sub(1);
+    m_droppedCycles.fetch_add(1);
+  }
+
+  void DegradableRateGroup ::
+    CycleIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Svc::TimerVal& cycleStart
+    )
+  {
+    FC_TRACE_SCOPE("rategroup", "RateGroup.cycle");
+    FC_TRACE_DISPATCH(m_queueFlow, "queue", "RateGroup");
+    // Cycles still waiting behind this one
+    const U32 backlog = m_pendingCycles.load() - 1;
+
+    if (backlog > 0 && !m_degraded) {
+      m_degraded = true;
+      m_degradedCycles = 0;
+      log_WARNING_HI_EnteredDegradedMode(backlog);
+    } else if (backlog == 0 && m_degraded) {
+      m_degraded = false;
+      log_ACTIVITY_HI_ExitedDegradedMode(m_degradedCycles);
+      // Re-arm the throttled events for the next episode
+      log_WARNING_LO_MemberShed_ThrottleClear();
+      log_WARNING_HI_CycleDropped_ThrottleClear();
+    }
+    if (m_degraded) {
+      m_degradedCycles++;
+    }
+
+    for (NATIVE_INT_TYPE port = 0; port < CONNECTION_COUNT_MAX; port++) {
+      if (m_degraded && m_classes[port] == DegradableRateGroup_MemberClass::DEFERRABLE) {
+        skipMember(port);
+      } else {
+        runMember(port);
+      }
+    }
+
+    // Deferred calls run in spare time: only once caught up and only if no new cycle arrived meanwhile
+    if (!m_degraded) {
+      for (NATIVE_INT_TYPE port = 0; port < CONNECTION_COUNT_MAX; port++) {
+        if (!m_owed[port]) {
+          continue;
+        }
+        if (m_pendingCycles.load() > 1) {
+          break;
+        }
+        m_owed[port] = false;
+        m_deferredRuns++;
+        runMember(port);
+      }
+    }
+
+    Svc::TimerVal end;
+    end.take();
+    const U32 cycleTimeUs = end.diffUSec(cycleStart);
+    if (cycleTimeUs > m_maxTimeUs) {
+      m_maxTimeUs = cycleTimeUs;
+    }
+
+    // A cycle that arrived while the members were running means this one slipped
+    if (m_pendingCycles.fetch_sub(1) > 1) {
+      m_cycleSlips++;
+    }
+
+    const U32 dropped = m_droppedCycles.load();
+    if (dropped > 0 && dropped != m_droppedCyclesReported) {
+      m_droppedCyclesReported = dropped;
+      log_WARNING_HI_CycleDropped(dropped);
+    }
+
+    tlmWrite_RgMaxTime(m_maxTimeUs);
+    tlmWrite_RgCycleSlips(m_cycleSlips);
+    tlmWrite_Degraded(m_degraded);
+    tlmWrite_DeferredRuns(m_deferredRuns);
+    tlmWrite_ShedPerMember(m_shedCounts);
+    tlmWrite_ShedTotal(m_shedTotal);
+    tlmWrite_CyclesDropped(dropped);
+  }
+
+  void DegradableRateGroup ::
+    PingIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 key
+    )
+  {
+    PingOut_out(0, key);
+  }
+
+} // end namespace FlightComputer
@@ -0,0 +1,102 @@
+#ifndef DegradableRateGroup_HPP
+#define DegradableRateGroup_HPP
+
+#include "FlightComputer/DegradableRateGroup/DegradableRateGroupComponentAc.hpp"
+#include "FlightComputer/DegradableRateGroup/DegradableRateGroup_MemberClassEnumAc.hpp"
+#include "FlightComputer/DegradableRateGroup/DegradableRateGroup_ShedCountsArrayAc.hpp"
+#include "FlightComputer/Trace/Trace.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+#include <atomic>
+
+namespace FlightComputer {
+  class DegradableRateGroup :
+  public DegradableRateGroupComponentBase
+  {
+
+    public:
+
+        static constexpr NATIVE_INT_TYPE CONNECTION_COUNT_MAX = NUM_RATEGROUPMEMBEROUT_OUTPUT_PORTS;
+
+        // ----------------------------------------------------------------------
+        // Construction, initialization, and destruction
+        // ----------------------------------------------------------------------
+
+        //! Construct object DegradableRateGroup
+        //!
+        DegradableRateGroup(
+            const char *const compName /*!< The component name*/
+        );
+
+        //! Initialize object DegradableRateGroup
+        //!
+        void init(
+            const NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
+            const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+        );
+
+        //! Configure the member contexts and classes. Call once the ports are connected.
+        //!
+        //! classes must cover every connected member port and end on a connected one, so a table that drifted from
+        //! the topology fails at startup rather than misclassifying members.
+        //!
+        void configure(
+            const NATIVE_INT_TYPE contexts[], /*!< Context passed to each member port*/
+            const NATIVE_INT_TYPE numContexts, /*!< Number of entries in contexts*/
+            const DegradableRateGroup_MemberClass::T classes[], /*!< Class of each member port*/
+            const NATIVE_INT_TYPE numClasses /*!< Number of entries in classes*/
+        );
+
+        //! Destroy object DegradableRateGroup
+        //!
+        ~DegradableRateGroup();
+
+    PRIVATE:
+
+        NATIVE_UINT_TYPE m_contexts[CONNECTION_COUNT_MAX];
+        DegradableRateGroup_MemberClass::T m_classes[CONNECTION_COUNT_MAX];
+        bool m_owed[CONNECTION_COUNT_MAX]; //!< A deferred call is waiting for the group to catch up
+
+        //! Cycles accepted by CycleIn but not yet handled, including the one being handled
+        std::atomic<U32> m_pendingCycles;
+        //! Cycles dropped because the queue was full, counted on the caller's thread
+        std::atomic<U32> m_droppedCycles;
+        U32 m_droppedCyclesReported;
+
+        bool m_degraded;
+        U32 m_degradedCycles;
+        U32 m_cycleSlips;
+        U32 m_maxTimeUs;
+        U32 m_deferredRuns;
+        U32 m_shedTotal;
+        DegradableRateGroup_ShedCounts m_shedCounts;
+
+        // Pairs queued cycles with their dispatch in traces
+        Trace::QueueFlow m_queueFlow;
+
+        //! Run one member port, if connected
+        void runMember(const NATIVE_INT_TYPE port);
+
+        //! Account for a deferrable member skipped in degraded mode
+        void skipMember(const NATIVE_INT_TYPE port);
+
+        void CycleIn_preMsgHook(const NATIVE_INT_TYPE portNum, Svc::TimerVal& cycleStart);
+        void CycleIn_overflowHook(const NATIVE_INT_TYPE portNum, Svc::TimerVal& cycleStart);
+
+        //! Handler implementation for CycleIn
+        //!
+        void CycleIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            Svc::TimerVal& cycleStart /*!< Cycle start timestamp*/
+        );
+
+        //! Handler implementation for PingIn
+        //!
+        void PingIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            U32 key /*!< Value to return to pinger*/
+        );
+
+    };
+
+} // end namespace FlightComputer
+#endif
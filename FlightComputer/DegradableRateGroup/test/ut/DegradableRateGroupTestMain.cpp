@@ -0,0 +1,36 @@
+// ======================================================================
+// \title  DegradableRateGroupTestMain.cpp
+// \brief  test main for DegradableRateGroup
+// ======================================================================
+
+#include "DegradableRateGroupTester.hpp"
+
+TEST(Nominal, OnTime) {
+  FlightComputer::DegradableRateGroupTester tester;
+  tester.testOnTime();
+}
+
+TEST(Degraded, EnterAndExit) {
+  FlightComputer::DegradableRateGroupTester tester;
+  tester.testDegradedMode();
+}
+
+TEST(Degraded, DeferThenShed) {
+  FlightComputer::DegradableRateGroupTester tester;
+  tester.testDeferThenShed();
+}
+
+TEST(Degraded, ShedThrottleClears) {
+  FlightComputer::DegradableRateGroupTester tester;
+  tester.testShedThrottleClears();
+}
+
+TEST(Configure, Asserts) {
+  FlightComputer::DegradableRateGroupTester tester;
+  tester.testConfigureAsserts();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
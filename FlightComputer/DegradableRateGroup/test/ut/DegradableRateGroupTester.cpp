@@ -0,0 +1,253 @@
+// ======================================================================
+// \title  DegradableRateGroupTester.cpp
+// \brief  cpp file for DegradableRateGroup component test harness implementation class
+// ======================================================================
+
+#include "DegradableRateGroupTester.hpp"
+#include <Svc/Cycle/TimerVal.hpp>
+
+namespace FlightComputer {
+
+  namespace {
+    // Every member port is connected to the tester. One is deferrable and the rest are critical.
+    const NATIVE_INT_TYPE CRITICAL_PORT = 0;
+    const NATIVE_INT_TYPE DEFERRABLE_PORT = 1;
+    const NATIVE_INT_TYPE MEMBERS = DegradableRateGroup::CONNECTION_COUNT_MAX;
+
+    // Matches the throttle of MemberShed in DegradableRateGroup.fpp
+    const U32 MEMBER_SHED_THROTTLE = 10;
+
+    //! Member classes with DEFERRABLE_PORT deferrable, padded by one entry for the oversized table test
+    void fillClasses(DegradableRateGroup_MemberClass::T classes[MEMBERS + 1]) {
+      for (NATIVE_INT_TYPE port = 0; port <= MEMBERS; port++) {
+        classes[port] = (port == DEFERRABLE_PORT) ? DegradableRateGroup_MemberClass::DEFERRABLE
+                                                  : DegradableRateGroup_MemberClass::CRITICAL;
+      }
+    }
+
+    //! Contexts that identify their port, padded by one entry for the oversized table test
+    void fillContexts(NATIVE_INT_TYPE contexts[MEMBERS + 1]) {
+      for (NATIVE_INT_TYPE port = 0; port <= MEMBERS; port++) {
+        contexts[port] = 100 + port;
+      }
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  DegradableRateGroupTester ::
+    DegradableRateGroupTester() :
+      DegradableRateGroupGTestBase("DegradableRateGroupTester", DegradableRateGroupTester::MAX_HISTORY_SIZE),
+      component("DegradableRateGroup")
+  {
+    this->initComponents();
+    this->connectPorts();
+    NATIVE_INT_TYPE contexts[MEMBERS + 1];
+    DegradableRateGroup_MemberClass::T classes[MEMBERS + 1];
+    fillContexts(contexts);
+    fillClasses(classes);
+    this->component.configure(contexts, MEMBERS, classes, MEMBERS);
+  }
+
+  DegradableRateGroupTester ::
+    ~DegradableRateGroupTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void DegradableRateGroupTester ::
+    testOnTime()
+  {
+    this->queueCycles(1);
+    this->dispatchCycles(1);
+
+    // Every member runs once with its context, in port order
+    ASSERT_from_RateGroupMemberOut_SIZE(MEMBERS);
+    for (NATIVE_INT_TYPE port = 0; port < MEMBERS; port++) {
+      ASSERT_EQ(this->memberPorts[port], port);
+      ASSERT_from_RateGroupMemberOut(port, static_cast<U32>(100 + port));
+    }
+    ASSERT_EVENTS_SIZE(0);
+    ASSERT_TLM_Degraded(0, false);
+    ASSERT_TLM_RgCycleSlips(0, 0);
+  }
+
+  void DegradableRateGroupTester ::
+    testDegradedMode()
+  {
+    // A cycle queued behind the first one puts the group behind
+    this->queueCycles(2);
+    this->dispatchCycles(1);
+    ASSERT_EVENTS_EnteredDegradedMode_SIZE(1);
+    ASSERT_EVENTS_EnteredDegradedMode(0, 1);
+    ASSERT_TLM_Degraded(0, true);
+    ASSERT_TLM_RgCycleSlips(0, 1);
+    ASSERT_EQ(this->memberCalls(CRITICAL_PORT), 1U);
+    ASSERT_EQ(this->memberCalls(DEFERRABLE_PORT), 0U);
+
+    // With nothing queued behind it the next cycle runs every member, then the deferred call
+    this->clearMemberCalls();
+    this->dispatchCycles(1);
+    ASSERT_EVENTS_ExitedDegradedMode_SIZE(1);
+    ASSERT_EVENTS_ExitedDegradedMode(0, 1);
+    ASSERT_TLM_Degraded_SIZE(2);
+    ASSERT_TLM_Degraded(1, false);
+    ASSERT_EQ(this->memberCalls(CRITICAL_PORT), 1U);
+    ASSERT_EQ(this->memberCalls(DEFERRABLE_PORT), 2U);
+    ASSERT_EQ(this->memberPorts.back(), DEFERRABLE_PORT);
+    ASSERT_TLM_DeferredRuns(1, 1);
+    ASSERT_EVENTS_MemberShed_SIZE(0);
+  }
+
+  void DegradableRateGroupTester ::
+    testDeferThenShed()
+  {
+    // Three cycles handled behind: the first skipped call is deferred, the next two are shed
+    const U32 degraded = 3;
+    this->queueCycles(degraded + 1);
+    this->dispatchCycles(degraded);
+    ASSERT_EVENTS_EnteredDegradedMode(0, degraded);
+    ASSERT_EQ(this->memberCalls(CRITICAL_PORT), degraded);
+    ASSERT_EQ(this->memberCalls(DEFERRABLE_PORT), 0U);
+    ASSERT_EVENTS_MemberShed_SIZE(degraded - 1);
+    for (U32 shed = 0; shed < degraded - 1; shed++) {
+      ASSERT_EVENTS_MemberShed(shed, static_cast<U32>(DEFERRABLE_PORT), shed + 1);
+    }
+    const U32 last = this->tlmHistory_ShedPerMember->size() - 1;
+    const DegradableRateGroup_ShedCounts& counts = this->tlmHistory_ShedPerMember->at(last).arg;
+    for (NATIVE_INT_TYPE port = 0; port < MEMBERS; port++) {
+      ASSERT_EQ(counts[port], (port == DEFERRABLE_PORT) ? degraded - 1 : 0U);
+    }
+    ASSERT_EQ(this->tlmHistory_ShedTotal->at(this->tlmHistory_ShedTotal->size() - 1).arg, degraded - 1);
+
+    // Catching up runs the one deferred call; shed calls are gone
+    this->clearMemberCalls();
+    this->dispatchCycles(1);
+    ASSERT_EVENTS_ExitedDegradedMode(0, degraded);
+    ASSERT_EQ(this->memberCalls(DEFERRABLE_PORT), 2U);
+    ASSERT_EQ(this->tlmHistory_DeferredRuns->at(this->tlmHistory_DeferredRuns->size() - 1).arg, 1U);
+
+    // Nothing is owed any more, so the next cycle runs each member once
+    this->clearMemberCalls();
+    this->queueCycles(1);
+    this->dispatchCycles(1);
+    ASSERT_EQ(this->memberCalls(DEFERRABLE_PORT), 1U);
+  }
+
+  void DegradableRateGroupTester ::
+    testShedThrottleClears()
+  {
+    // A long episode sheds more calls than the throttle lets through
+    const U32 degraded = MEMBER_SHED_THROTTLE + 2;
+    this->queueCycles(degraded + 1);
+    this->dispatchCycles(degraded + 1);
+    const U32 shed = degraded - 1;
+    ASSERT_EVENTS_MemberShed_SIZE(MEMBER_SHED_THROTTLE);
+    ASSERT_EVENTS_ExitedDegradedMode_SIZE(1);
+    ASSERT_EQ(this->tlmHistory_ShedTotal->at(this->tlmHistory_ShedTotal->size() - 1).arg, shed);
+
+    // The next episode's first shed is reported again, with the running count
+    this->clearEvents();
+    this->queueCycles(3);
+    this->dispatchCycles(3);
+    ASSERT_EVENTS_EnteredDegradedMode(0, 2);
+    ASSERT_EVENTS_MemberShed_SIZE(1);
+    ASSERT_EVENTS_MemberShed(0, static_cast<U32>(DEFERRABLE_PORT), shed + 1);
+    ASSERT_EVENTS_ExitedDegradedMode_SIZE(1);
+  }
+
+  void DegradableRateGroupTester ::
+    testConfigureAsserts()
+  {
+    NATIVE_INT_TYPE contexts[MEMBERS + 1];
+    DegradableRateGroup_MemberClass::T classes[MEMBERS + 1];
+    fillContexts(contexts);
+    fillClasses(classes);
+
+    // Missing tables, and tables longer than there are member ports
+    ASSERT_DEATH(this->component.configure(nullptr, MEMBERS, classes, MEMBERS), "");
+    ASSERT_DEATH(this->component.configure(contexts, MEMBERS, nullptr, MEMBERS), "");
+    ASSERT_DEATH(this->component.configure(contexts, MEMBERS + 1, classes, MEMBERS), "");
+    ASSERT_DEATH(this->component.configure(contexts, MEMBERS, classes, MEMBERS + 1), "");
+
+    // A class table that stops short of a connected member
+    ASSERT_DEATH(this->component.configure(contexts, MEMBERS, classes, MEMBERS - 1), "");
+
+    // A class table that runs past the last connected member
+    DegradableRateGroup unconnected("unconnected");
+    unconnected.init(TEST_INSTANCE_QUEUE_DEPTH, TEST_INSTANCE_ID + 1);
+    ASSERT_DEATH(unconnected.configure(contexts, 1, classes, 1), "");
+    unconnected.configure(contexts, 0, classes, 0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  void DegradableRateGroupTester ::
+    from_RateGroupMemberOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 context
+    )
+  {
+    this->memberPorts.push_back(portNum);
+    this->pushFromPortEntry_RateGroupMemberOut(context);
+  }
+
+  void DegradableRateGroupTester ::
+    from_PingOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 key
+    )
+  {
+    this->pushFromPortEntry_PingOut(key);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void DegradableRateGroupTester ::
+    queueCycles(const U32 count)
+  {
+    for (U32 n = 0; n < count; n++) {
+      Svc::TimerVal cycleStart;
+      cycleStart.take();
+      this->invoke_to_CycleIn(0, cycleStart);
+    }
+  }
+
+  void DegradableRateGroupTester ::
+    dispatchCycles(const U32 count)
+  {
+    for (U32 n = 0; n < count; n++) {
+      ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    }
+  }
+
+  U32 DegradableRateGroupTester ::
+    memberCalls(const NATIVE_INT_TYPE port) const
+  {
+    U32 count = 0;
+    for (const NATIVE_INT_TYPE called : this->memberPorts) {
+      if (called == port) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  void DegradableRateGroupTester ::
+    clearMemberCalls()
+  {
+    this->memberPorts.clear();
+    this->clearFromPortHistory();
+  }
+
+}
@@ -0,0 +1,125 @@
+// ======================================================================
+// \title  DegradableRateGroupTester.hpp
+// \brief  hpp file for DegradableRateGroup component test harness implementation class
+// ======================================================================
+
+#ifndef FlightComputer_DegradableRateGroupTester_HPP
+#define FlightComputer_DegradableRateGroupTester_HPP
+
+#include "FlightComputer/DegradableRateGroup/DegradableRateGroup.hpp"
+#include "FlightComputer/DegradableRateGroup/DegradableRateGroupGTestBase.hpp"
+#include <vector>
+
+namespace FlightComputer {
+
+  class DegradableRateGroupTester :
+    public DegradableRateGroupGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Maximum size of histories storing events, telemetry, and port outputs
+      static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 256;
+
+      //! Instance ID supplied to the component instance under test
+      static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+
+      //! Queue depth supplied to the component instance under test, enough to back up a long degraded episode
+      static const NATIVE_INT_TYPE TEST_INSTANCE_QUEUE_DEPTH = 16;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object DegradableRateGroupTester
+      DegradableRateGroupTester();
+
+      //! Destroy object DegradableRateGroupTester
+      ~DegradableRateGroupTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Cycles handled on time run every member
+      void testOnTime();
+
+      //! A backlog enters degraded mode, suspending the deferrable member, and catching up leaves it
+      void testDegradedMode();
+
+      //! The first skipped call of a deferrable member is deferred and later ones are shed
+      void testDeferThenShed();
+
+      //! Catching up clears the MemberShed throttle, so the next episode reports its sheds again
+      void testShedThrottleClears();
+
+      //! configure() rejects tables that do not match the connected member ports
+      void testConfigureAsserts();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for RateGroupMemberOut
+      void from_RateGroupMemberOut_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          U32 context //!< The call order
+      );
+
+      //! Handler implementation for PingOut
+      void from_PingOut_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          U32 key //!< Value to return to pinger
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Queue count cycles on CycleIn, as the driver would while the group is busy
+      void queueCycles(const U32 count);
+
+      //! Handle count queued cycles
+      void dispatchCycles(const U32 count);
+
+      //! Member calls made on port since the last clearMemberCalls()
+      U32 memberCalls(const NATIVE_INT_TYPE port) const;
+
+      //! Forget the member calls made so far
+      void clearMemberCalls();
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      DegradableRateGroup component;
+
+      //! Member port of each call, in call order
+      std::vector<NATIVE_INT_TYPE> memberPorts;
+
+  };
+
+}
+
+#endif
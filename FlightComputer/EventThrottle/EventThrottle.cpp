@@ -0,0 +1,271 @@
+// ======================================================================
+// \title  EventThrottle.cpp
+// \brief  cpp file for EventThrottle component implementation class
+// ======================================================================
+
+#include <FlightComputer/EventThrottle/EventThrottle.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace FlightComputer {
+
+  namespace {
+    const U32 TABLE_BITS = 7;
+    static_assert((1U << TABLE_BITS) == EventThrottle::TABLE_SIZE, "TABLE_BITS must match TABLE_SIZE");
+
+    // Rates used until configure is called
+    const U32 DEFAULT_BURST = 5;
+    const U32 DEFAULT_WARNING_HI_BURST = 15;
+    const U32 DEFAULT_RATE_PER_SECOND = 2;
+    const U32 DEFAULT_DRAIN_PER_TICK = 10;
+
+    //! A storm that ended, reported once the lock is released
+    struct StormSummary {
+      FwEventIdType id;
+      U32 count;
+    };
+  }
+
+  EventThrottle ::
+    EventThrottle(
+        const char *const compName
+    ) : EventThrottleComponentBase(compName),
+        m_tickRateHz(1),
+        m_capacity(DEFAULT_BURST),
+        m_warningHiCapacity(DEFAULT_WARNING_HI_BURST),
+        m_refillPerTick(DEFAULT_RATE_PER_SECOND),
+        m_drainPerTick(DEFAULT_DRAIN_PER_TICK),
+        m_tick(0),
+        m_stormCount(0),
+        m_forwarded(0),
+        m_throttled(0),
+        m_untracked(0)
+  {
+    for (U32 index = 0; index <= TABLE_SIZE; index++) {
+      m_buckets[index].id = 0;
+      m_buckets[index].used = (index == TABLE_SIZE);
+      m_buckets[index].storming = false;
+      m_buckets[index].warningHi = false;
+      m_buckets[index].tokens = m_capacity;
+      m_buckets[index].lastTick = 0;
+      m_buckets[index].suppressed = 0;
+    }
+    for (U32 level = 0; level < PRIORITY_LEVELS; level++) {
+      m_queues[level].head = 0;
+      m_queues[level].count = 0;
+      m_queues[level].drops = 0;
+    }
+  }
+
+  EventThrottle ::~EventThrottle() {}
+
+  void EventThrottle ::
+    init(
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    EventThrottleComponentBase::init(instance);
+  }
+
+  void EventThrottle ::
+    configure(
+        const U32 tickRateHz,
+        const U32 burst,
+        const U32 warningHiBurst,
+        const U32 ratePerSecond,
+        const U32 drainPerTick
+    )
+  {
+    FW_ASSERT(tickRateHz > 0);
+    FW_ASSERT(burst > 0);
+    // A full burst from one warning high ID fits its queue
+    FW_ASSERT(warningHiBurst >= burst && warningHiBurst <= QUEUE_DEPTH, warningHiBurst, burst);
+    FW_ASSERT(drainPerTick > 0);
+    m_lock.lock();
+    m_tickRateHz = tickRateHz;
+    m_capacity = burst * tickRateHz;
+    m_warningHiCapacity = warningHiBurst * tickRateHz;
+    m_refillPerTick = ratePerSecond;
+    m_drainPerTick = drainPerTick;
+    for (U32 index = 0; index <= TABLE_SIZE; index++) {
+      m_buckets[index].tokens = capacity(m_buckets[index]);
+    }
+    m_lock.unLock();
+  }
+
+  U32 EventThrottle ::priority(const Fw::LogSeverity& severity) {
+    switch (severity.e) {
+      case Fw::LogSeverity::WARNING_HI:
+        return 0;
+      case Fw::LogSeverity::WARNING_LO:
+        return 1;
+      default:
+        return 2;
+    }
+  }
+
+  EventThrottle::Bucket& EventThrottle ::bucket(const FwEventIdType id, const Fw::LogSeverity& severity) {
+    const U32 home = (static_cast<U32>(id) * 2654435761U) >> (32 - TABLE_BITS);
+    for (U32 probe = 0; probe < TABLE_SIZE; probe++) {
+      Bucket& b = m_buckets[(home + probe) & (TABLE_SIZE - 1)];
+      if (b.used && b.id == id) {
+        return b;
+      }
+      if (!b.used) {
+        b.id = id;
+        b.used = true;
+        b.warningHi = (severity == Fw::LogSeverity::WARNING_HI);
+        b.tokens = capacity(b);
+        b.lastTick = m_tick;
+        return b;
+      }
+    }
+    // Table full: every further ID shares the overflow bucket, which reports the last of them and keeps the smaller
+    // burst whatever their severity
+    Bucket& overflow = m_buckets[TABLE_SIZE];
+    overflow.id = id;
+    m_untracked++;
+    return overflow;
+  }
+
+  U32 EventThrottle ::capacity(const Bucket& b) const {
+    return b.warningHi ? m_warningHiCapacity : m_capacity;
+  }
+
+  bool EventThrottle ::admit(Bucket& b) {
+    const U32 full = capacity(b);
+    const U64 refill = static_cast<U64>(m_tick - b.lastTick) * m_refillPerTick;
+    b.tokens = (refill >= full - b.tokens) ? full : b.tokens + static_cast<U32>(refill);
+    b.lastTick = m_tick;
+    if (b.tokens < m_tickRateHz) {
+      return false;
+    }
+    b.tokens -= m_tickRateHz;
+    return true;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void EventThrottle ::
+    LogRecv_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwEventIdType id,
+        Fw::Time& timeTag,
+        const Fw::LogSeverity& severity,
+        Fw::LogBuffer& args
+    )
+  {
+    if (severity == Fw::LogSeverity::FATAL || severity == Fw::LogSeverity::COMMAND) {
+      // The logger announces fatals to the fatal handler, and the ground matches every command it sent to its
+      // acknowledgement; nothing may hold either back. Command events come one or two per command, so the uplink
+      // rate already bounds them.
+      LogSend_out(0, id, timeTag, severity, args);
+      return;
+    }
+
+    m_lock.lock();
+    // Warning high IDs get a larger burst, so a fault report is heard in full while a chattering one is still cut
+    // down and summarized. Storm summaries are bounded by the table size and must not be lost to their own bucket.
+    if (id != getIdBase() + EVENTID_EVENTSSUPPRESSED) {
+      Bucket& b = bucket(id, severity);
+      if (!admit(b)) {
+        b.suppressed++;
+        m_throttled++;
+        if (!b.storming) {
+          b.storming = true;
+          m_storms[m_stormCount++] = static_cast<U32>(&b - m_buckets);
+        }
+        m_lock.unLock();
+        return;
+      }
+    }
+
+    Queue& queue = m_queues[priority(severity)];
+    if (queue.count == QUEUE_DEPTH) {
+      queue.drops++;
+    } else {
+      Record& record = queue.records[(queue.head + queue.count) % QUEUE_DEPTH];
+      record.id = id;
+      record.timeTag = timeTag;
+      record.severity = severity;
+      record.args = args;
+      queue.count++;
+    }
+    m_lock.unLock();
+  }
+
+  void EventThrottle ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    StormSummary ended[TABLE_SIZE + 1];
+    U32 endedCount = 0;
+
+    m_lock.lock();
+    const U32 tick = ++m_tick;
+    const U32 tickRateHz = m_tickRateHz;
+    const U32 drainPerTick = m_drainPerTick;
+    // A storm has ended once its ID has been quiet for a second
+    for (U32 s = 0; s < m_stormCount;) {
+      Bucket& b = m_buckets[m_storms[s]];
+      if (tick - b.lastTick < tickRateHz) {
+        s++;
+        continue;
+      }
+      ended[endedCount].id = b.id;
+      ended[endedCount].count = b.suppressed;
+      endedCount++;
+      b.suppressed = 0;
+      b.storming = false;
+      m_storms[s] = m_storms[--m_stormCount];
+    }
+    m_lock.unLock();
+
+    for (U32 s = 0; s < endedCount; s++) {
+      log_WARNING_LO_EventsSuppressed(ended[s].id, ended[s].count);
+    }
+
+    // Forward a bounded number of queued events, highest priority first
+    Record record;
+    for (U32 sent = 0; sent < drainPerTick; sent++) {
+      m_lock.lock();
+      U32 level = 0;
+      while (level < PRIORITY_LEVELS && m_queues[level].count == 0) {
+        level++;
+      }
+      if (level == PRIORITY_LEVELS) {
+        m_lock.unLock();
+        break;
+      }
+      Queue& queue = m_queues[level];
+      record = queue.records[queue.head];
+      queue.head = (queue.head + 1) % QUEUE_DEPTH;
+      queue.count--;
+      m_forwarded++;
+      m_lock.unLock();
+
+      LogSend_out(0, record.id, record.timeTag, record.severity, record.args);
+    }
+
+    if (tick % tickRateHz == 0) {
+      EventThrottle_PriorityCounts drops;
+      m_lock.lock();
+      const U32 forwarded = m_forwarded;
+      const U32 throttled = m_throttled;
+      const U32 untracked = m_untracked;
+      for (U32 level = 0; level < PRIORITY_LEVELS; level++) {
+        drops[level] = m_queues[level].drops;
+      }
+      m_lock.unLock();
+
+      tlmWrite_EventsForwarded(forwarded);
+      tlmWrite_EventsThrottled(throttled);
+      tlmWrite_QueueDrops(drops);
+      tlmWrite_UntrackedEvents(untracked);
+    }
+  }
+
+} // end namespace FlightComputer
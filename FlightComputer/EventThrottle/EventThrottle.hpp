@@ -0,0 +1,139 @@
+#ifndef EventThrottle_HPP
+#define EventThrottle_HPP
+
+#include "FlightComputer/EventThrottle/EventThrottleComponentAc.hpp"
+#include "FlightComputer/EventThrottle/EventThrottle_PriorityCountsArrayAc.hpp"
+#include "Fw/Log/LogBuffer.hpp"
+#include "Fw/Time/Time.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+#include "Os/Mutex.hpp"
+
+namespace FlightComputer {
+  class EventThrottle :
+  public EventThrottleComponentBase
+  {
+
+    public:
+
+        static const U32 PRIORITY_LEVELS = EventThrottle_PriorityCounts::SIZE;
+        //! Event IDs tracked with their own bucket, a power of two; further IDs share one overflow bucket
+        static const U32 TABLE_SIZE = 128;
+        //! Events each priority level can hold while waiting for schedIn
+        static const U32 QUEUE_DEPTH = 16;
+
+        // ----------------------------------------------------------------------
+        // Construction, initialization, and destruction
+        // ----------------------------------------------------------------------
+
+        //! Construct object EventThrottle
+        //!
+        EventThrottle(
+            const char *const compName /*!< The component name*/
+        );
+
+        //! Initialize object EventThrottle
+        //!
+        void init(
+            const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+        );
+
+        //! Set the rates. Until this is called every ID may send 5 events at once, 15 for warning high IDs, and 2 per
+        //! second after that.
+        //!
+        //! Forwarding of queued events is capped at drainPerTick * tickRateHz events per second, which must stay
+        //! within what the event logger queue and the downlink can absorb besides fatal and command events.
+        //!
+        void configure(
+            const U32 tickRateHz, /*!< Rate schedIn is called at*/
+            const U32 burst, /*!< Events an ID may send back to back*/
+            const U32 warningHiBurst, /*!< Events a warning high ID may send back to back, burst to QUEUE_DEPTH*/
+            const U32 ratePerSecond, /*!< Sustained events per second per ID*/
+            const U32 drainPerTick /*!< Events forwarded per schedIn call*/
+        );
+
+        //! Destroy object EventThrottle
+        //!
+        ~EventThrottle();
+
+    PRIVATE:
+
+        //! Token bucket of one event ID. Tokens are counted in 1/tickRateHz of an event so refills stay integral.
+        struct Bucket {
+            FwEventIdType id;
+            bool used;
+            bool storming; //!< In the storm list
+            bool warningHi; //!< Claimed by a warning high event, so it gets the larger burst
+            U32 tokens;
+            U32 lastTick; //!< Tick of the last event from this ID, when the bucket was last refilled
+            U32 suppressed; //!< Events dropped since the storm started
+        };
+
+        //! An admitted event waiting to be forwarded
+        struct Record {
+            FwEventIdType id;
+            Fw::Time timeTag;
+            Fw::LogSeverity severity;
+            Fw::LogBuffer args;
+        };
+
+        //! Fixed FIFO of records for one priority level
+        struct Queue {
+            Record records[QUEUE_DEPTH];
+            U32 head;
+            U32 count;
+            U32 drops;
+        };
+
+        //! Priority level of a severity, 0 being forwarded first
+        static U32 priority(const Fw::LogSeverity& severity);
+
+        //! Bucket for id, claimed on first sight by an event of the given severity. Caller holds m_lock.
+        Bucket& bucket(const FwEventIdType id, const Fw::LogSeverity& severity);
+
+        //! Full bucket b, in token units. Caller holds m_lock.
+        U32 capacity(const Bucket& b) const;
+
+        //! Take a token from b if it has one, refilling it first. Caller holds m_lock.
+        bool admit(Bucket& b);
+
+        //! Handler implementation for LogRecv
+        //!
+        void LogRecv_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            FwEventIdType id, /*!< Log ID*/
+            Fw::Time& timeTag, /*!< Time Tag*/
+            const Fw::LogSeverity& severity, /*!< The severity argument*/
+            Fw::LogBuffer& args /*!< Buffer containing serialized log entry*/
+        );
+
+        //! Handler implementation for schedIn
+        //!
+        void schedIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            NATIVE_UINT_TYPE context /*!< The call order*/
+        );
+
+        // Every member below is guarded by m_lock. Ports are sync rather than guarded so that events are sent,
+        // including this component's own (which come back in on LogRecv), without the lock held.
+        Os::Mutex m_lock;
+
+        U32 m_tickRateHz;
+        U32 m_capacity; //!< Full bucket, in token units
+        U32 m_warningHiCapacity; //!< Full warning high bucket, in token units
+        U32 m_refillPerTick; //!< Token units added per tick
+        U32 m_drainPerTick;
+        U32 m_tick;
+
+        Bucket m_buckets[TABLE_SIZE + 1]; //!< The last entry is the overflow bucket
+        U32 m_storms[TABLE_SIZE + 1]; //!< Indices of buckets that are suppressing
+        U32 m_stormCount;
+        Queue m_queues[PRIORITY_LEVELS];
+
+        U32 m_forwarded;
+        U32 m_throttled;
+        U32 m_untracked;
+
+    };
+
+} // end namespace FlightComputer
+#endif
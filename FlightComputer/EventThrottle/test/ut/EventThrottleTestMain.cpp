@@ -0,0 +1,31 @@
+// ======================================================================
+// \title  EventThrottleTestMain.cpp
+// \brief  test main for EventThrottle
+// ======================================================================
+
+#include "EventThrottleTester.hpp"
+
+TEST(Nominal, CommandBurst) {
+  FlightComputer::EventThrottleTester tester;
+  tester.testCommandBurst();
+}
+
+TEST(Nominal, WarningHiBurst) {
+  FlightComputer::EventThrottleTester tester;
+  tester.testWarningHiBurst();
+}
+
+TEST(Nominal, WarningHiStorm) {
+  FlightComputer::EventThrottleTester tester;
+  tester.testWarningHiStorm();
+}
+
+TEST(Nominal, ActivityBurst) {
+  FlightComputer::EventThrottleTester tester;
+  tester.testActivityBurst();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
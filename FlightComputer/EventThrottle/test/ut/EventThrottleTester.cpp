@@ -0,0 +1,212 @@
+// ======================================================================
+// \title  EventThrottleTester.cpp
+// \brief  cpp file for EventThrottle component test harness implementation class
+// ======================================================================
+
+#include "EventThrottleTester.hpp"
+
+namespace FlightComputer {
+
+  namespace {
+    // Rates the component is configured with, those of the deployment
+    const U32 TICK_RATE_HZ = 200;
+    const U32 BURST = 5;
+    const U32 WARNING_HI_BURST = 15;
+    const U32 RATE_PER_SECOND = 2;
+    const U32 DRAIN_PER_TICK = 2;
+
+    // Event IDs sent through the throttle: cmdDisp's OpCodeCompleted and made up ones
+    const FwEventIdType OP_CODE_COMPLETED_ID = 0x0502;
+    const FwEventIdType WARNING_ID = 0x1234;
+    const FwEventIdType ACTIVITY_ID = 0x1235;
+    const FwEventIdType WARNING_LO_ID = 0x1236;
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  EventThrottleTester ::
+    EventThrottleTester() :
+      EventThrottleGTestBase("EventThrottleTester", EventThrottleTester::MAX_HISTORY_SIZE),
+      component("EventThrottle")
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.configure(TICK_RATE_HZ, BURST, WARNING_HI_BURST, RATE_PER_SECOND, DRAIN_PER_TICK);
+  }
+
+  EventThrottleTester ::
+    ~EventThrottleTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void EventThrottleTester ::
+    testCommandBurst()
+  {
+    // Far more than the bucket holds and more than a priority queue holds, with no tick in between
+    const U32 count = 100;
+    this->sendEvents(OP_CODE_COMPLETED_ID, Fw::LogSeverity::COMMAND, count);
+
+    // Every acknowledgement is out before the next tick, in order
+    ASSERT_from_LogSend_SIZE(count);
+    for (U32 n = 0; n < count; n++) {
+      const FromPortEntry_LogSend& entry = this->fromPortHistory_LogSend->at(n);
+      ASSERT_EQ(entry.id, OP_CODE_COMPLETED_ID);
+      ASSERT_EQ(entry.severity, Fw::LogSeverity::COMMAND);
+      Fw::LogBuffer args = entry.args;
+      args.resetDeser();
+      U32 sequence = 0;
+      ASSERT_EQ(args.deserialize(sequence), Fw::FW_SERIALIZE_OK);
+      ASSERT_EQ(sequence, n);
+    }
+
+    // Nothing was counted as throttled or dropped, and no storm is reported
+    this->tick(TICK_RATE_HZ);
+    ASSERT_from_LogSend_SIZE(count);
+    ASSERT_EVENTS_EventsSuppressed_SIZE(0);
+    ASSERT_TLM_EventsThrottled(0, 0);
+    EventThrottle_PriorityCounts noDrops;
+    for (U32 level = 0; level < EventThrottle::PRIORITY_LEVELS; level++) {
+      noDrops[level] = 0;
+    }
+    ASSERT_TLM_QueueDrops(0, noDrops);
+  }
+
+  void EventThrottleTester ::
+    testWarningHiBurst()
+  {
+    // More than other IDs may send back to back, all of it forwarded
+    const U32 count = WARNING_HI_BURST;
+    ASSERT_GT(count, BURST);
+    this->sendEvents(WARNING_ID, Fw::LogSeverity::WARNING_HI, count);
+    ASSERT_from_LogSend_SIZE(0);
+
+    this->tick(count / DRAIN_PER_TICK + 1);
+    ASSERT_EQ(this->forwarded(WARNING_ID), count);
+
+    this->tick(TICK_RATE_HZ);
+    ASSERT_EVENTS_EventsSuppressed_SIZE(0);
+    ASSERT_TLM_EventsThrottled(0, 0);
+  }
+
+  void EventThrottleTester ::
+    testWarningHiStorm()
+  {
+    // A warning high ID chattering at 400 events per second for two seconds, while an activity and a warning low ID
+    // each send within their rate
+    const U32 seconds = 2;
+    const U32 stormPerTick = 2;
+    const U32 otherPeriodTicks = TICK_RATE_HZ / RATE_PER_SECOND;
+    U32 stormSent = 0;
+    U32 otherSent = 0;
+    for (U32 t = 0; t < seconds * TICK_RATE_HZ; t++) {
+      this->sendEvents(WARNING_ID, Fw::LogSeverity::WARNING_HI, stormPerTick);
+      stormSent += stormPerTick;
+      if (t % otherPeriodTicks == 0) {
+        this->sendEvents(ACTIVITY_ID, Fw::LogSeverity::ACTIVITY_HI, 1);
+        this->sendEvents(WARNING_LO_ID, Fw::LogSeverity::WARNING_LO, 1);
+        otherSent++;
+      }
+      this->tick(1);
+    }
+
+    // The lower priority events all got through behind the storm
+    ASSERT_EQ(this->forwarded(ACTIVITY_ID), otherSent);
+    ASSERT_EQ(this->forwarded(WARNING_LO_ID), otherSent);
+
+    // The storm was cut to its burst plus its sustained rate, and nothing overflowed a queue
+    const U32 stormForwarded = this->forwarded(WARNING_ID);
+    ASSERT_GE(stormForwarded, WARNING_HI_BURST);
+    ASSERT_LE(stormForwarded, WARNING_HI_BURST + RATE_PER_SECOND * seconds + 1);
+    EventThrottle_PriorityCounts noDrops;
+    for (U32 level = 0; level < EventThrottle::PRIORITY_LEVELS; level++) {
+      noDrops[level] = 0;
+    }
+    ASSERT_TLM_QueueDrops(this->tlmHistory_QueueDrops->size() - 1, noDrops);
+
+    // Once the ID has been quiet for a second the storm is summarized with everything it lost
+    ASSERT_EVENTS_EventsSuppressed_SIZE(0);
+    this->tick(TICK_RATE_HZ);
+    ASSERT_EVENTS_EventsSuppressed_SIZE(1);
+    ASSERT_EVENTS_EventsSuppressed(0, WARNING_ID, stormSent - stormForwarded);
+  }
+
+  void EventThrottleTester ::
+    testActivityBurst()
+  {
+    const U32 count = 2 * BURST;
+    this->sendEvents(ACTIVITY_ID, Fw::LogSeverity::ACTIVITY_HI, count);
+
+    this->tick(BURST);
+    ASSERT_EQ(this->forwarded(ACTIVITY_ID), BURST);
+
+    // The storm is summarized once the ID has been quiet for a second
+    ASSERT_EVENTS_EventsSuppressed_SIZE(0);
+    this->tick(TICK_RATE_HZ);
+    ASSERT_EVENTS_EventsSuppressed_SIZE(1);
+    ASSERT_EVENTS_EventsSuppressed(0, ACTIVITY_ID, count - BURST);
+    ASSERT_TLM_EventsThrottled(0, count - BURST);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  void EventThrottleTester ::
+    from_LogSend_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwEventIdType id,
+        Fw::Time& timeTag,
+        const Fw::LogSeverity& severity,
+        Fw::LogBuffer& args
+    )
+  {
+    this->pushFromPortEntry_LogSend(id, timeTag, severity, args);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void EventThrottleTester ::
+    sendEvents(
+        const FwEventIdType id,
+        const Fw::LogSeverity::T severity,
+        const U32 count
+    )
+  {
+    for (U32 n = 0; n < count; n++) {
+      Fw::Time timeTag(TB_NONE, 0, n);
+      Fw::LogBuffer args;
+      ASSERT_EQ(args.serialize(n), Fw::FW_SERIALIZE_OK);
+      this->invoke_to_LogRecv(0, id, timeTag, severity, args);
+    }
+  }
+
+  void EventThrottleTester ::
+    tick(const U32 ticks)
+  {
+    for (U32 t = 0; t < ticks; t++) {
+      this->invoke_to_schedIn(0, 0);
+    }
+  }
+
+  U32 EventThrottleTester ::
+    forwarded(const FwEventIdType id) const
+  {
+    U32 count = 0;
+    for (U32 n = 0; n < this->fromPortHistory_LogSend->size(); n++) {
+      if (this->fromPortHistory_LogSend->at(n).id == id) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+}
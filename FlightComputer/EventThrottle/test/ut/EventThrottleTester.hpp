@@ -0,0 +1,109 @@
+// ======================================================================
+// \title  EventThrottleTester.hpp
+// \brief  hpp file for EventThrottle component test harness implementation class
+// ======================================================================
+
+#ifndef FlightComputer_EventThrottleTester_HPP
+#define FlightComputer_EventThrottleTester_HPP
+
+#include "FlightComputer/EventThrottle/EventThrottle.hpp"
+#include "FlightComputer/EventThrottle/EventThrottleGTestBase.hpp"
+
+namespace FlightComputer {
+
+  class EventThrottleTester :
+    public EventThrottleGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Maximum size of histories storing events, telemetry, and port outputs
+      static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 256;
+
+      //! Instance ID supplied to the component instance under test
+      static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object EventThrottleTester
+      EventThrottleTester();
+
+      //! Destroy object EventThrottleTester
+      ~EventThrottleTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! A burst of command acknowledgements is forwarded whole and at once
+      void testCommandBurst();
+
+      //! A burst of warning high events up to their larger bucket is queued and forwarded whole
+      void testWarningHiBurst();
+
+      //! A warning high storm is rate limited and summarized without starving lower priority events
+      void testWarningHiStorm();
+
+      //! A burst of activity events is cut to the bucket and summarized once the ID goes quiet
+      void testActivityBurst();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for LogSend
+      void from_LogSend_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwEventIdType id, //!< Log ID
+          Fw::Time& timeTag, //!< Time Tag
+          const Fw::LogSeverity& severity, //!< The severity argument
+          Fw::LogBuffer& args //!< Buffer containing serialized log entry
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Send count events of one ID and severity to LogRecv, each carrying its sequence number
+      void sendEvents(const FwEventIdType id, const Fw::LogSeverity::T severity, const U32 count);
+
+      //! Call schedIn ticks times
+      void tick(const U32 ticks);
+
+      //! Number of forwarded events with the given ID
+      U32 forwarded(const FwEventIdType id) const;
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      EventThrottle component;
+
+  };
+
+}
+
+#endif
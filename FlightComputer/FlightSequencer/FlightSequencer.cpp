@@ -10,7 +10,6 @@
 #include "Drv/DataTypes/DataBuffer.hpp"
 #include "FlightComputer/Common/Common.hpp"
 #include "FlightComputer/FlightSequencer/FlightSequencer_FlightSMStatesEnumAc.hpp"
-#include "FlightComputer/FlightSequencer/FppConstantsAc.hpp"
 #include "FlightSM.hpp"
 #include "FlightSequencer.hpp"
 #include "Fw/Sm/SmSignalBuffer.hpp"
@@ -20,8 +19,9 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cmath>
 #include <csignal>
-#include "FlightComputer/Common/Common.hpp"
+#include "FlightComputer/Trace/Trace.hpp"
 
 
 namespace FlightComputer {
@@ -38,19 +38,29 @@ namespace FlightComputer {
 
   // Check if T-burn time is reached using Fw::Time
   bool FlightSequencer::FlightSM_isTBurnReached(const FwEnumStoreType stateMachineId) {
+    FC_TRACE_SCOPE("FlightSM", "guard:isTBurnReached");
+
+    FW_ASSERT(physics != nullptr);
 
     Fw::Time currentTime = Fw::Time(timeCnt++, 0);  // Get the current time
-    Fw::Time burnDuration = Fw::Time(250, 0); // Burn time (tburn) in seconds
+    Fw::Time burnDuration = Fw::Time(physics->tBurnS, 0); // Burn time (tburn) in seconds
     return currentTime >= burnDuration;        // Check if burn time is reached
   }
 
+  F32 FlightSequencer::guardAltitudeM() {
+    estimateLock.lock();
+    F32 altitude = hasEstimate ? estimatedAltitudeM : status.getaltitudeM();
+    estimateLock.unLock();
+    return altitude;
+  }
+
   void FlightSequencer::FlightSM_checkLowAltReached(const FwEnumStoreType stateMachineId) {
-    if (status.getaltitudeM() < 50) {
-        Fw::SmSignalBuffer data;
+    FC_TRACE_SCOPE("FlightSM", "action:checkLowAltReached");
+    if (guardAltitudeM() < 50) {
         signalLock.lock();
 
         lastSignal = FlightSM_Signals::TERMINATE_SIG;
-        flightSM.update(this->stateMachineId, lastSignal, data);
+        dispatchSignal("signal:TERMINATE");
 
         signalLock.unLock();
     }
@@ -58,40 +68,57 @@ namespace FlightComputer {
 
   // Initialize flight status at the beginning of the flight using Fw::Time
   void FlightSequencer::FlightSM_initFlightStatus(const FwEnumStoreType stateMachineId) {
+    FC_TRACE_SCOPE("FlightSM", "action:initFlightStatus");
     // Reset the flight status to start simulation
     Fw::Logger::log("Init flight status\n");
     timeCnt = 0;
 
     status.set(false, 0.0, 0.0, FlightSequencer_FlightSMStates::IDLE); // Reset time, engine state, altitude, and velocity
+    // The estimator restarts along with the truth, and the guards use the truth until its first new estimate
+    estimateLock.lock();
+    hasEstimate = false;
+    estimateLock.unLock();
+    if (isConnected_estimatorResetOut_OutputPort(0)) {
+      estimatorResetOut_out(0);
+    }
+    if (isConnected_truthOut_OutputPort(0)) {
+      truthOut_out(0, 0.0, 0.0, 0.0);
+    }
   }
 
   // Engage thrust (transition from Idle to Powered flight)
   void FlightSequencer::FlightSM_engageThrust(const FwEnumStoreType stateMachineId) {
+    FC_TRACE_SCOPE("FlightSM", "action:engageThrust");
     Fw::Logger::log("Engaging thrust\n");
     status.setisEngineOn(true);  // Set engine ON
   }
 
   // Disengage thrust (transition from Powered flight to Ballistic flight)
   void FlightSequencer::FlightSM_disengageThrust(const FwEnumStoreType stateMachineId) {
+    FC_TRACE_SCOPE("FlightSM", "action:disengageThrust");
     Fw::Logger::log("Disengaging thrust\n");
     status.setisEngineOn(false); // Set engine OFF
   }
 
   // Update flight status using Fw::Time for time intervals
   void FlightSequencer::FlightSM_updateFlightStatus(const FwEnumStoreType stateMachineId) {
+    FC_TRACE_SCOPE("FlightSM", "action:updateFlightStatus");
     // Get current status parameters
     F32 velocity = status.getvelocityMS();      // Get current velocity
     F32 altitude = status.getaltitudeM();       // Get current altitude
 
     Fw::Time dt = Fw::Time(1, 0);               // Define a 1-second timestep
+    F32 accel;
+    FW_ASSERT(physics != nullptr);
 
     if (status.getisEngineOn()) {
       // Powered flight phase
-      velocity += (FlightSequencer_thrustN / FlightSequencer_massKg - FlightSequencer_gravityMSS) * dt.getSeconds(); // Calculate velocity during powered flight
+      accel = physics->thrustN / physics->massKg - physics->gravityMSS; // Acceleration during powered flight
     } else {
       // Ballistic flight phase (free fall)
-      velocity += (-FlightSequencer_gravityMSS) * dt.getSeconds();        // Calculate velocity during free fall
+      accel = -physics->gravityMSS;        // Acceleration during free fall
     }
+    velocity += accel * dt.getSeconds();
 
     altitude += velocity * dt.getSeconds();      // Update altitude based on new velocity
     
@@ -99,6 +126,11 @@ namespace FlightComputer {
     // status.setflightTimeS(status.getflightTimeS() + dt.getSeconds());          // Increment current time by dt
     status.setvelocityMS(velocity);             // Set updated velocity
     status.setaltitudeM(altitude);              // Set updated altitude
+
+    // Feed the sensor simulation behind the state estimator
+    if (isConnected_truthOut_OutputPort(0)) {
+      truthOut_out(0, altitude, velocity, accel);
+    }
   }
 
   void FlightSequencer ::
@@ -112,10 +144,93 @@ namespace FlightComputer {
     Fw::Logger::log("SM state on init %d\n", flightSM.state);
   }
 
+  // ----------------------------------------------------------------------
+  // Parameters
+  // ----------------------------------------------------------------------
+
+  void FlightSequencer ::parametersLoaded() {
+    publishPhysics();
+  }
+
+  void FlightSequencer ::parameterUpdated(FwPrmIdType id) {
+    publishPhysics();
+  }
+
+  void FlightSequencer ::publishPhysics() {
+    Fw::ParamValid valid;
+    PhysicsParams params;
+    params.thrustN = paramGet_THRUST_N(valid);
+    params.massKg = paramGet_MASS_KG(valid);
+    params.tBurnS = paramGet_T_BURN_S(valid);
+    params.gravityMSS = paramGet_GRAVITY_MSS(valid);
+
+    // An uplinked value that would put inf or NaN into the integration is refused as a set
+    if (!physicsValid(params)) {
+      publishLock.lock();
+      publishPending.store(false, std::memory_order_relaxed);
+      publishLock.unLock();
+      log_WARNING_HI_PhysicsParamsRejected(params.thrustN, params.massKg, params.gravityMSS);
+      return;
+    }
+
+    publishLock.lock();
+    const bool published = physicsCell.publish(params);
+    // A burst of updates within one run can use up the slots; run publishes the latest values once they free up
+    publishPending.store(!published, std::memory_order_relaxed);
+    publishLock.unLock();
+
+    if (published) {
+      log_ACTIVITY_HI_PhysicsParamsApplied(params.thrustN, params.massKg, params.tBurnS, params.gravityMSS);
+    }
+  }
+
+  bool FlightSequencer ::physicsValid(const PhysicsParams& params) {
+    return std::isfinite(params.thrustN) && params.thrustN >= 0 &&
+           std::isfinite(params.massKg) && params.massKg > 0 &&
+           std::isfinite(params.gravityMSS) && params.gravityMSS >= 0 &&
+           std::isfinite(params.thrustN / params.massKg);
+  }
+
   // ----------------------------------------------------------------------
   // Handler implementations for user-defined typed input ports
   // ----------------------------------------------------------------------
 
+  void FlightSequencer ::
+    estimateIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        F32 altitudeM,
+        F32 velocityMS,
+        F32 altitudeVar
+    )
+  {
+    estimateLock.lock();
+    hasEstimate = true;
+    estimatedAltitudeM = altitudeM;
+    estimateLock.unLock();
+  }
+
+  void FlightSequencer ::dispatchSignal(const char* signalName) {
+    FC_TRACE_SCOPE("FlightSM", signalName);
+    const I32 fromState = static_cast<I32>(flightSM.state);
+
+    Fw::SmSignalBuffer data;
+    flightSM.update(this->stateMachineId, lastSignal, data);
+
+    const I32 toState = static_cast<I32>(flightSM.state);
+    if (fromState != toState) {
+      FC_TRACE_INSTANT("FlightSM", "transition", fromState, toState);
+    }
+  }
+
+  void FlightSequencer ::terminateFlight() {
+    signalLock.lock();
+
+    lastSignal = FlightSM_Signals::TERMINATE_SIG;
+    dispatchSignal("signal:TERMINATE");
+
+    signalLock.unLock();
+  }
+
   bool FlightSequencer ::updateTlms() {
     tlmWrite_flightStatus(status);
     return true;
@@ -127,19 +242,31 @@ namespace FlightComputer {
         NATIVE_UINT_TYPE context
     )
   {
+    FC_TRACE_SCOPE("port", "FlightSequencer.run");
+    FC_TRACE_DISPATCH(queueFlow, "queue", "FlightSequencer");
+
+    // The only shared read of the physics inputs this run. There is none if the loaded values were all rejected; the
+    // flight does not advance until valid ones are set.
+    physics = physicsCell.load();
+    if (physics == nullptr) {
+      physicsCell.quiescent();
+      return;
+    }
 
     FW_CHECK(updateTlms(), "Failed to update tlms");
 
     Fw::CmdResponse ret = Fw::CmdResponse::OK;
 
-    Fw::SmSignalBuffer data;
+    const char* signalName;
     signalLock.lock();
     // Once every few calls, send the TBURN_CHECK_SIG signal
     if (signalCounter++ >= 2) {
         lastSignal = FlightSM_Signals::TBURN_CHECK_INTERVAL_SIG;
+        signalName = "signal:TBURN_CHECK_INTERVAL";
         signalCounter = 0;  // Reset the counter after sending the TBURN_CHECK_SIG signal
     } else {
         lastSignal = FlightSM_Signals::UPDATE_INTERVAL_SIG;
+        signalName = "signal:UPDATE_INTERVAL";
     }
 
     // FIXME Using static_cast to convert the integer to the enum type
@@ -149,11 +276,33 @@ namespace FlightComputer {
 
     signalLock.unlock();
 
-    flightSM.update(this->stateMachineId, lastSignal, data);
+    dispatchSignal(signalName);
 
     FW_CHECK(ret == Fw::CmdResponse::OK,
              "Run Failed, aborting",
-             this->TERMINATE_cmdHandler(0, 10))
+             this->terminateFlight())
+
+    physics = nullptr;
+    physicsCell.quiescent();
+    if (publishPending.load(std::memory_order_relaxed)) {
+      publishPhysics();
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Pre-message hooks, run on the caller's thread as each message is queued
+  // ----------------------------------------------------------------------
+
+  void FlightSequencer ::run_preMsgHook(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+    FC_TRACE_ENQUEUE(queueFlow, "queue", "FlightSequencer");
+  }
+
+  void FlightSequencer ::IGNITE_preMsgHook(const FwOpcodeType opCode, const U32 cmdSeq) {
+    FC_TRACE_ENQUEUE(queueFlow, "queue", "FlightSequencer");
+  }
+
+  void FlightSequencer ::TERMINATE_preMsgHook(const FwOpcodeType opCode, const U32 cmdSeq) {
+    FC_TRACE_ENQUEUE(queueFlow, "queue", "FlightSequencer");
   }
 
   // ----------------------------------------------------------------------
@@ -166,11 +315,13 @@ namespace FlightComputer {
         const U32 cmdSeq
     )
   {
+    FC_TRACE_SCOPE("port", "FlightSequencer.IGNITE");
+    FC_TRACE_DISPATCH(queueFlow, "queue", "FlightSequencer");
+
     signalLock.lock();
 
-    Fw::SmSignalBuffer data;
     lastSignal = FlightSM_Signals::IGNITE_SIG;
-    flightSM.update(this->stateMachineId, lastSignal, data);
+    dispatchSignal("signal:IGNITE");
 
     signalLock.unLock();
 
@@ -184,13 +335,10 @@ namespace FlightComputer {
         const U32 cmdSeq
     )
   {
-    Fw::SmSignalBuffer data;
-    signalLock.lock();
+    FC_TRACE_SCOPE("port", "FlightSequencer.TERMINATE");
+    FC_TRACE_DISPATCH(queueFlow, "queue", "FlightSequencer");
 
-    lastSignal = FlightSM_Signals::TERMINATE_SIG;
-    flightSM.update(this->stateMachineId, lastSignal, data);
-
-    signalLock.unLock();
+    terminateFlight();
 
     cmdResponse_out(opCode,cmdSeq,Fw::CmdResponse::OK);
   }
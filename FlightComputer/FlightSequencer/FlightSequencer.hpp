@@ -7,8 +7,12 @@
 #include "FlightComputer/FlightSequencer/FlightSequencer_statusSerializableAc.hpp"
 #include "Fw/Types/BasicTypes.hpp"
 #include "FlightComputer/FlightSequencer/FlightSequencerComponentAc.hpp"
+#include "FlightComputer/Common/SnapshotCell.hpp"
+#include "FlightComputer/Trace/Trace.hpp"
 #include "Os/Mutex.hpp"
 
+#include <atomic>
+
 namespace FlightComputer {
   class FlightSequencer :
   public FlightSequencerComponentBase, public FlightSM_Interface
@@ -47,6 +51,31 @@ namespace FlightComputer {
 
     PRIVATE:
 
+        //! Physics inputs, published together whenever a parameter changes
+        struct PhysicsParams {
+            F32 thrustN;
+            F32 massKg;
+            U32 tBurnS;
+            F32 gravityMSS;
+        };
+
+        //! Parameter handling, called on the loading or commanding thread
+        void parametersLoaded();
+        void parameterUpdated(FwPrmIdType id);
+
+        //! Snapshot the current parameter values for the flight loop, keeping the previous snapshot if one is invalid
+        void publishPhysics();
+
+        //! Whether params give finite flight dynamics: positive mass, non-negative thrust and gravity
+        static bool physicsValid(const PhysicsParams& params);
+
+        // Only the component thread reads snapshots; it holds one for the duration of each run
+        SnapshotCell<PhysicsParams, 4> physicsCell;
+        const PhysicsParams* physics = nullptr;
+        // Serializes publishers; a publish that found no free slot is retried by run
+        Os::Mutex publishLock;
+        std::atomic<bool> publishPending{false};
+
         FwSizeType signalCounter;
         FlightSequencer_status status; // = {0, false, 0, 0};
         FlightSM flightSM;
@@ -55,8 +84,29 @@ namespace FlightComputer {
         Os::Mutex signalLock;
         U32 timeCnt =0;
 
+        // Latest estimate from the state estimator, written from its thread
+        Os::Mutex estimateLock;
+        bool hasEstimate = false;
+        F32 estimatedAltitudeM = 0;
+
+        //! Altitude the guards should act on: the estimate when one is available, otherwise the ideal value
+        F32 guardAltitudeM();
+
+        // Pairs queued messages with their dispatch in traces
+        Trace::QueueFlow queueFlow;
+
         bool updateTlms();
 
+        //! Feed lastSignal to the state machine, tracing the signal and any resulting transition
+        void dispatchSignal(const char* signalName);
+
+        //! Send TERMINATE to the state machine. Carries no queue trace hooks, so it can be called from any handler.
+        void terminateFlight();
+
+        void run_preMsgHook(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context);
+        void IGNITE_preMsgHook(const FwOpcodeType opCode, const U32 cmdSeq);
+        void TERMINATE_preMsgHook(const FwOpcodeType opCode, const U32 cmdSeq);
+
         //! Handler implementation for run
         //!
         void run_handler(
@@ -65,6 +115,14 @@ namespace FlightComputer {
         The call order
         */
         );
+        //! Handler implementation for estimateIn
+        //!
+        void estimateIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            F32 altitudeM,
+            F32 velocityMS,
+            F32 altitudeVar
+        );
         void IGNITE_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq);
         void TERMINATE_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq);
 
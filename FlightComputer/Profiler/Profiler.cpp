@@ -0,0 +1,89 @@
+// ======================================================================
+// \title  Profiler.cpp
+// \brief  cpp file for Profiler component implementation class
+// ======================================================================
+
+#include <FlightComputer/Profiler/Profiler.hpp>
+#include <FlightComputer/Profiler/Sampler.hpp>
+
+namespace FlightComputer {
+
+  Profiler ::
+    Profiler(
+        const char *const compName
+    ) : ProfilerComponentBase(compName)
+  {
+
+  }
+
+  Profiler ::~Profiler() {
+    Sampler::stop();
+  }
+
+  void Profiler ::
+    init(
+        const NATIVE_INT_TYPE queueDepth,
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    ProfilerComponentBase::init(queueDepth, instance);
+  }
+
+  // ----------------------------------------------------------------------
+  // Command handler implementations
+  // ----------------------------------------------------------------------
+
+  void Profiler ::
+    PROFILE_START_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        U32 frequencyHz
+    )
+  {
+    if (frequencyHz == 0 || frequencyHz > Sampler::MAX_FREQUENCY_HZ) {
+      log_WARNING_LO_ProfileFrequencyInvalid(frequencyHz, Sampler::MAX_FREQUENCY_HZ);
+      cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+    // Restarting begins a fresh profile
+    Sampler::stop();
+    U32 threads = 0;
+    const I32 error = Sampler::start(frequencyHz, threads);
+    if (error != 0) {
+      log_WARNING_HI_ProfileStartFailed(error);
+      cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    log_ACTIVITY_HI_ProfileStarted(frequencyHz, threads);
+    cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void Profiler ::
+    PROFILE_STOP_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    Sampler::stop();
+    log_ACTIVITY_HI_ProfileStopped(Sampler::samples(), Sampler::droppedSamples());
+    cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void Profiler ::
+    PROFILE_DUMP_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& fileName
+    )
+  {
+    U32 stacks = 0;
+    if (!Sampler::dump(fileName.toChar(), stacks)) {
+      log_WARNING_HI_ProfileDumpFailed(fileName);
+      cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    log_ACTIVITY_HI_ProfileDumped(fileName, stacks, Sampler::samples());
+    cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+} // end namespace FlightComputer
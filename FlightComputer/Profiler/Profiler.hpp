@@ -0,0 +1,44 @@
+#ifndef Profiler_HPP
+#define Profiler_HPP
+
+#include "FlightComputer/Profiler/ProfilerComponentAc.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+
+namespace FlightComputer {
+  class Profiler :
+  public ProfilerComponentBase
+  {
+
+    public:
+
+        // ----------------------------------------------------------------------
+        // Construction, initialization, and destruction
+        // ----------------------------------------------------------------------
+
+        //! Construct object Profiler
+        //!
+        Profiler(
+            const char *const compName /*!< The component name*/
+        );
+
+        //! Initialize object Profiler
+        //!
+        void init(
+            const NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
+            const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+        );
+
+        //! Destroy object Profiler
+        //!
+        ~Profiler();
+
+    PRIVATE:
+
+        void PROFILE_START_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, U32 frequencyHz);
+        void PROFILE_STOP_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq);
+        void PROFILE_DUMP_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, const Fw::CmdStringArg& fileName);
+
+    };
+
+} // end namespace FlightComputer
+#endif
@@ -0,0 +1,417 @@
+#include <FlightComputer/Profiler/Sampler.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Older C libraries do not name the target thread field of a SIGEV_THREAD_ID sigevent
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace FlightComputer {
+namespace Sampler {
+
+namespace {
+
+const int SAMPLE_SIGNAL = SIGPROF;
+const U64 KEY_EMPTY = 0;
+const U64 KEY_BUSY = 1;  //!< Claimed by a handler that is still filling the entry in
+const U32 MAX_PROBES = 64;
+// How long start() waits for a thread to report its identity before sampling it without a stack walk
+const U32 IDENTIFY_TIMEOUT_US = 100000;
+
+// Entries are immutable once their key is published, except for the count
+struct Entry {
+    std::atomic<U64> key;  //!< Stack hash, or KEY_EMPTY / KEY_BUSY
+    std::atomic<U32> count;
+    U32 thread;
+    U32 depth;
+    uintptr_t pcs[MAX_DEPTH];
+};
+
+struct Thread {
+    pid_t tid;
+    timer_t timer;
+    char name[24];
+    // Stack of the thread, [stackLow, stackHigh); empty if it could not be found, so no frame is walked
+    uintptr_t stackLow;
+    uintptr_t stackHigh;
+    pthread_t handle;  //!< Reported by the thread itself from the signal handler
+    std::atomic<bool> identified;
+};
+
+Entry s_entries[STACK_ENTRIES];
+Thread s_threads[MAX_THREADS];
+U32 s_threadCount = 0;
+std::atomic<bool> s_running(false);
+std::atomic<U32> s_inHandler(0);
+std::atomic<U32> s_samples(0);
+std::atomic<U32> s_dropped(0);
+bool s_handlerInstalled = false;
+
+static_assert((STACK_ENTRIES & (STACK_ENTRIES - 1)) == 0, "STACK_ENTRIES must be a power of two");
+
+//! Interrupted program counter and frame pointer
+bool interruptedFrame(void* context, uintptr_t& pc, uintptr_t& fp) {
+    const ucontext_t* const uc = static_cast<const ucontext_t*>(context);
+#if defined(__x86_64__)
+    pc = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RIP]);
+    fp = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RBP]);
+    return true;
+#elif defined(__aarch64__)
+    pc = static_cast<uintptr_t>(uc->uc_mcontext.pc);
+    fp = static_cast<uintptr_t>(uc->uc_mcontext.regs[29]);
+    return true;
+#else
+    (void)uc;
+    pc = 0;
+    fp = 0;
+    return false;
+#endif
+}
+
+//! Walk the frame pointer chain of the interrupted thread. Async-signal-safe: only reads the two words of each frame,
+//! and only once they are known to lie inside the thread's stack.
+U32 unwind(void* context, const Thread& thread, uintptr_t pcs[MAX_DEPTH]) {
+    uintptr_t pc = 0;
+    uintptr_t fp = 0;
+    if (!interruptedFrame(context, pc, fp)) {
+        return 0;
+    }
+    pcs[0] = pc;
+    U32 depth = 1;
+
+    while (depth < MAX_DEPTH) {
+        // Both ABIs store the caller's frame pointer at fp and the return address just above it
+        if (fp < thread.stackLow || fp >= thread.stackHigh || thread.stackHigh - fp < 2 * sizeof(uintptr_t) ||
+            (fp & (sizeof(uintptr_t) - 1)) != 0) {
+            break;
+        }
+        const uintptr_t* const frame = reinterpret_cast<const uintptr_t*>(fp);
+        const uintptr_t next = frame[0];
+        const uintptr_t ret = frame[1];
+        if (ret == 0) {
+            break;
+        }
+        pcs[depth++] = ret;
+        // Callers' frames lie strictly above their callees', so a chain that does not climb is not a chain
+        if (next <= fp) {
+            break;
+        }
+        fp = next;
+    }
+    return depth;
+}
+
+U64 hashStack(const U32 thread, const uintptr_t pcs[], const U32 depth) {
+    U64 hash = 14695981039346656037ULL ^ thread;
+    for (U32 i = 0; i < depth; i++) {
+        hash = (hash ^ static_cast<U64>(pcs[i])) * 1099511628211ULL;
+    }
+    return (hash > KEY_BUSY) ? hash : hash + 2;
+}
+
+bool sameStack(const Entry& entry, const U32 thread, const uintptr_t pcs[], const U32 depth) {
+    if (entry.thread != thread || entry.depth != depth) {
+        return false;
+    }
+    for (U32 i = 0; i < depth; i++) {
+        if (entry.pcs[i] != pcs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Count a sample of weight periods. Lock-free; an entry still being filled in by another thread is skipped, which may at worst
+//! split one stack over two entries (the dump format adds duplicate lines up).
+void count(const U32 thread, const uintptr_t pcs[], const U32 depth, const U32 weight) {
+    const U64 hash = hashStack(thread, pcs, depth);
+    for (U32 probe = 0; probe < MAX_PROBES; probe++) {
+        Entry& entry = s_entries[(hash + probe) & (STACK_ENTRIES - 1)];
+        U64 key = entry.key.load(std::memory_order_acquire);
+        if (key == KEY_EMPTY && entry.key.compare_exchange_strong(key, KEY_BUSY, std::memory_order_acquire)) {
+            entry.thread = thread;
+            entry.depth = depth;
+            for (U32 i = 0; i < depth; i++) {
+                entry.pcs[i] = pcs[i];
+            }
+            entry.count.store(weight, std::memory_order_relaxed);
+            entry.key.store(hash, std::memory_order_release);
+            s_samples.fetch_add(weight, std::memory_order_relaxed);
+            return;
+        }
+        if (key == hash && sameStack(entry, thread, pcs, depth)) {
+            entry.count.fetch_add(weight, std::memory_order_relaxed);
+            s_samples.fetch_add(weight, std::memory_order_relaxed);
+            return;
+        }
+    }
+    s_dropped.fetch_add(weight, std::memory_order_relaxed);
+}
+
+void onSample(int signal, siginfo_t* info, void* context) {
+    const int savedErrno = errno;
+    s_inHandler.fetch_add(1);
+    // Timers and identify requests carry the thread's slot
+    const U32 thread = static_cast<U32>(info->si_value.sival_int);
+    if (info->si_code == SI_QUEUE && info->si_pid == getpid() && thread < s_threadCount &&
+        s_threads[thread].tid == static_cast<pid_t>(syscall(SYS_gettid))) {
+        // Only the thread itself can name its pthread handle; start() looks up the stack from it
+        s_threads[thread].handle = pthread_self();
+        s_threads[thread].identified.store(true, std::memory_order_release);
+    } else if (s_running.load() && info->si_code == SI_TIMER && thread < s_threadCount) {
+        uintptr_t pcs[MAX_DEPTH];
+        const U32 depth = unwind(context, s_threads[thread], pcs);
+        // CPU timers are checked on the scheduler tick, so at high rates several periods can pass per signal; the
+        // overrun count keeps the profile proportional to CPU time
+        const U32 weight = 1 + static_cast<U32>((info->si_overrun > 0) ? info->si_overrun : 0);
+        if (depth > 0) {
+            count(thread, pcs, depth, weight);
+        }
+    }
+    s_inHandler.fetch_sub(1);
+    errno = savedErrno;
+}
+
+//! Thread name from /proc, made unique with the thread id if another sampled thread already has it
+void threadName(const pid_t tid, const U32 slot) {
+    char path[64];
+    char comm[16] = "";
+    (void)snprintf(path, sizeof(path), "/proc/self/task/%d/comm", static_cast<int>(tid));
+    FILE* file = fopen(path, "r");
+    if (file != nullptr) {
+        if (fgets(comm, sizeof(comm), file) == nullptr) {
+            comm[0] = '\0';
+        }
+        (void)fclose(file);
+    }
+    comm[strcspn(comm, "\n; ")] = '\0';
+
+    bool unique = (comm[0] != '\0');
+    for (U32 other = 0; unique && other < slot; other++) {
+        unique = (strcmp(s_threads[other].name, comm) != 0);
+    }
+    if (unique) {
+        (void)snprintf(s_threads[slot].name, sizeof(s_threads[slot].name), "%s", comm);
+    } else {
+        (void)snprintf(s_threads[slot].name, sizeof(s_threads[slot].name), "%s-%d", (comm[0] != '\0') ? comm : "tid",
+                       static_cast<int>(tid));
+    }
+}
+
+//! The CPU clock of any thread in the process, by thread id (Linux clock id encoding)
+clockid_t threadCpuClock(const pid_t tid) {
+    const clockid_t PERTHREAD = 4;
+    const clockid_t SCHED = 2;
+    return static_cast<clockid_t>((~static_cast<U32>(tid)) << 3) | PERTHREAD | SCHED;
+}
+
+//! Find the stack bounds of every sampled thread. Each thread is asked, by a queued signal, for its pthread handle,
+//! which pthread_getattr_np then takes the stack from. A thread that does not answer within IDENTIFY_TIMEOUT_US of
+//! the requests (e.g. it blocks the signal) keeps an empty stack and is sampled without a walk.
+void findStacks() {
+    const pid_t pid = getpid();
+    for (U32 slot = 0; slot < s_threadCount; slot++) {
+        siginfo_t info;
+        (void)memset(&info, 0, sizeof(info));
+        info.si_signo = SAMPLE_SIGNAL;
+        info.si_code = SI_QUEUE;
+        info.si_pid = pid;
+        info.si_uid = getuid();
+        info.si_value.sival_int = static_cast<int>(slot);
+        (void)syscall(SYS_rt_tgsigqueueinfo, pid, s_threads[slot].tid, SAMPLE_SIGNAL, &info);
+    }
+    U32 slot = 0;
+    for (U32 waitedUs = 0; slot < s_threadCount && waitedUs < IDENTIFY_TIMEOUT_US; waitedUs += 1000) {
+        while (slot < s_threadCount && s_threads[slot].identified.load(std::memory_order_acquire)) {
+            slot++;
+        }
+        if (slot < s_threadCount) {
+            (void)usleep(1000);
+        }
+    }
+
+    for (slot = 0; slot < s_threadCount; slot++) {
+        Thread& thread = s_threads[slot];
+        if (!thread.identified.load(std::memory_order_acquire)) {
+            continue;
+        }
+        pthread_attr_t attributes;
+        if (pthread_getattr_np(thread.handle, &attributes) != 0) {
+            continue;
+        }
+        void* address = nullptr;
+        size_t size = 0;
+        if (pthread_attr_getstack(&attributes, &address, &size) == 0) {
+            thread.stackLow = reinterpret_cast<uintptr_t>(address);
+            thread.stackHigh = thread.stackLow + size;
+        }
+        (void)pthread_attr_destroy(&attributes);
+    }
+}
+
+void deleteTimers() {
+    for (U32 slot = 0; slot < s_threadCount; slot++) {
+        (void)timer_delete(s_threads[slot].timer);
+    }
+}
+
+}  // namespace
+
+I32 start(const U32 frequencyHz, U32& threads) {
+    FW_ASSERT(frequencyHz > 0 && frequencyHz <= MAX_FREQUENCY_HZ, frequencyHz);
+    threads = 0;
+    if (s_running.load()) {
+        return EBUSY;
+    }
+
+    for (U32 e = 0; e < STACK_ENTRIES; e++) {
+        s_entries[e].key.store(KEY_EMPTY, std::memory_order_relaxed);
+    }
+    s_samples.store(0);
+    s_dropped.store(0);
+
+    // Left installed once set: a signal still pending after stop() must not take the default (terminate) action
+    if (!s_handlerInstalled) {
+        struct sigaction action;
+        (void)memset(&action, 0, sizeof(action));
+        action.sa_sigaction = onSample;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        (void)sigemptyset(&action.sa_mask);
+        if (sigaction(SAMPLE_SIGNAL, &action, nullptr) != 0) {
+            return errno;
+        }
+        s_handlerInstalled = true;
+    }
+
+    DIR* tasks = opendir("/proc/self/task");
+    if (tasks == nullptr) {
+        return errno;
+    }
+    s_threadCount = 0;
+    const struct dirent* task = nullptr;
+    while (s_threadCount < MAX_THREADS && (task = readdir(tasks)) != nullptr) {
+        const pid_t tid = static_cast<pid_t>(atoi(task->d_name));
+        if (tid <= 0) {
+            continue;
+        }
+        Thread& thread = s_threads[s_threadCount];
+        struct sigevent event;
+        (void)memset(&event, 0, sizeof(event));
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SAMPLE_SIGNAL;
+        event.sigev_value.sival_int = static_cast<int>(s_threadCount);
+        event.sigev_notify_thread_id = tid;
+        if (timer_create(threadCpuClock(tid), &event, &thread.timer) != 0) {
+            // The thread exited since the directory was read
+            continue;
+        }
+        thread.tid = tid;
+        thread.stackLow = 0;
+        thread.stackHigh = 0;
+        thread.identified.store(false, std::memory_order_relaxed);
+        threadName(tid, s_threadCount);
+        s_threadCount++;
+    }
+    (void)closedir(tasks);
+    findStacks();
+
+    s_running.store(true);
+    const long periodNs = 1000000000L / static_cast<long>(frequencyHz);
+    struct itimerspec period;
+    period.it_interval.tv_sec = periodNs / 1000000000L;
+    period.it_interval.tv_nsec = periodNs % 1000000000L;
+    period.it_value = period.it_interval;
+    for (U32 slot = 0; slot < s_threadCount; slot++) {
+        if (timer_settime(s_threads[slot].timer, 0, &period, nullptr) != 0) {
+            const int error = errno;
+            stop();
+            return error;
+        }
+    }
+    threads = s_threadCount;
+    return 0;
+}
+
+void stop() {
+    if (!s_running.exchange(false)) {
+        return;
+    }
+    deleteTimers();
+    // A handler that saw s_running before it was cleared may still be counting its sample
+    while (s_inHandler.load() != 0) {
+        (void)usleep(100);
+    }
+}
+
+bool isRunning() {
+    return s_running.load(std::memory_order_relaxed);
+}
+
+U32 samples() {
+    return s_samples.load(std::memory_order_relaxed);
+}
+
+U32 droppedSamples() {
+    return s_dropped.load(std::memory_order_relaxed);
+}
+
+bool dump(const char* fileName, U32& stackCount) {
+    FW_ASSERT(fileName != nullptr);
+    stackCount = 0;
+
+    FILE* file = fopen(fileName, "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    for (U32 e = 0; e < STACK_ENTRIES; e++) {
+        const Entry& entry = s_entries[e];
+        const U64 key = entry.key.load(std::memory_order_acquire);
+        if (key == KEY_EMPTY || key == KEY_BUSY) {
+            continue;
+        }
+        (void)fputs(s_threads[entry.thread].name, file);
+        for (U32 i = entry.depth; i-- > 0;) {
+            // Return addresses point after the call; look up the call itself so tail positions resolve correctly
+            const uintptr_t pc = (i == 0) ? entry.pcs[i] : entry.pcs[i] - 1;
+            Dl_info info;
+            const bool found = (dladdr(reinterpret_cast<void*>(pc), &info) != 0);
+            if (found && info.dli_sname != nullptr) {
+                (void)fprintf(file, ";%s", info.dli_sname);
+            } else if (found && info.dli_fname != nullptr) {
+                // Not exported: module and offset, for addr2line on the ground
+                const char* base = strrchr(info.dli_fname, '/');
+                (void)fprintf(file, ";%s+0x%lx", (base != nullptr) ? base + 1 : info.dli_fname,
+                              static_cast<unsigned long>(pc - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+            } else {
+                (void)fprintf(file, ";0x%lx", static_cast<unsigned long>(pc));
+            }
+        }
+        (void)fprintf(file, " %u\n", entry.count.load(std::memory_order_relaxed));
+        stackCount++;
+    }
+
+    bool ok = (ferror(file) == 0);
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+}  // namespace Sampler
+}  // namespace FlightComputer
@@ -0,0 +1,62 @@
+#ifndef PROFILER_SAMPLER_H_
+#define PROFILER_SAMPLER_H_
+
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace FlightComputer {
+namespace Sampler {
+
+/**
+ * \brief in-process sampling profiler writing folded stacks
+ *
+ * start() arms one timer per thread of the process on that thread's CPU clock, so a thread is only sampled while it
+ * runs. Each expiry raises SIGPROF on the sampled thread, whose handler walks the frame pointer chain from the
+ * interrupted context and counts the stack in a static table of unique stacks. The walk never leaves the thread's own
+ * stack, whose bounds start() records for every thread. The handler takes no locks and does no allocation. When
+ * stopped no timer exists and nothing runs.
+ *
+ * Stacks are only complete for code built with frame pointers, and names resolve only for exported symbols (see the
+ * deployment CMakeLists.txt). Names are written mangled; demangle the dump on the ground, e.g.
+ * `c++filt < profile.folded | flamegraph.pl > profile.svg`.
+ */
+
+enum {
+    MAX_THREADS = 64,       //!< Threads sampled; any further threads are not
+    MAX_DEPTH = 32,         //!< Frames kept per sample, innermost first
+    STACK_ENTRIES = 4096,   //!< Unique stacks the table holds, a power of two
+    MAX_FREQUENCY_HZ = 1000,
+};
+
+//! Start sampling every current thread at frequencyHz of its CPU time. Clears the previous profile.
+//!
+//! \param frequencyHz: samples per second of CPU time per thread, 1 to MAX_FREQUENCY_HZ
+//! \param threads: receives the number of threads sampled
+//! \return 0 on success, otherwise the errno of the failed step
+I32 start(const U32 frequencyHz, U32& threads);
+
+//! Stop sampling. Returns once no sample is being taken anymore.
+void stop();
+
+bool isRunning();
+
+//! Sample periods counted since the last start. A signal that arrives after several periods counts for all of them.
+U32 samples();
+
+//! Sample periods lost because the stack table was full
+U32 droppedSamples();
+
+/**
+ * \brief write the profile as folded stacks, one line per stack: "task;outermost;...;innermost count"
+ *
+ * Sampling may continue during the dump; samples taken meanwhile may or may not be included.
+ *
+ * \param fileName: output path
+ * \param stackCount: receives the number of lines written
+ * \return false if the file could not be written
+ */
+bool dump(const char* fileName, U32& stackCount);
+
+}  // namespace Sampler
+}  // namespace FlightComputer
+
+#endif  // PROFILER_SAMPLER_H_
@@ -0,0 +1,324 @@
+#include <FlightComputer/RingFrameAccumulator/FrameScanner.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace FlightComputer {
+
+namespace {
+
+const U8 START_BYTE0 = static_cast<U8>(FrameScanner::START_WORD >> 24);
+const U8 START_BYTE1 = static_cast<U8>(FrameScanner::START_WORD >> 16);
+const U32 START_SIZE = 4;
+const U32 VECTOR_SIZE = 16;
+
+}  // namespace
+
+FrameScanner::FrameScanner()
+    : m_ring(nullptr),
+      m_size(0),
+      m_mask(0),
+      m_maxFrameSize(0),
+      m_head(0),
+      m_tail(0),
+      m_state(SEARCH),
+      m_payloadSize(0),
+      m_checksumPosition(0),
+      m_viewCount(0),
+      m_bytesDiscarded(0),
+      m_checksumFailures(0),
+      m_invalidSizes(0) {
+    for (U32 slot = 0; slot < MAX_VIEWS; slot++) {
+        m_views[slot].position = 0;
+        m_views[slot].size = 0;
+        m_views[slot].held = false;
+        m_views[slot].released.store(true);
+    }
+}
+
+void FrameScanner::setup(U8* storage, const U32 size, const U32 maxFrameSize) {
+    FW_ASSERT(storage != nullptr);
+    FW_ASSERT(size > 0 && (size & (size - 1)) == 0, size);
+    FW_ASSERT(maxFrameSize > HEADER_SIZE + TRAILER_SIZE && maxFrameSize <= size, maxFrameSize, size);
+    m_ring = storage;
+    m_size = size;
+    m_mask = size - 1;
+    m_maxFrameSize = maxFrameSize;
+}
+
+void FrameScanner::reclaim() {
+    for (U32 slot = 0; slot < MAX_VIEWS; slot++) {
+        if (m_views[slot].held && m_views[slot].released.load(std::memory_order_acquire)) {
+            m_views[slot].held = false;
+            m_viewCount--;
+        }
+    }
+}
+
+U32 FrameScanner::runFrom(const U32 position, const U32 limit, U32& blockerSize) const {
+    U32 run = limit;
+    blockerSize = 0;
+    for (U32 slot = 0; slot < MAX_VIEWS; slot++) {
+        const View& view = m_views[slot];
+        if (!view.held) {
+            continue;
+        }
+        // position is never inside a held frame, so this is how far ahead the frame starts
+        const U32 ahead = (view.position - position) & m_mask;
+        if (ahead < run) {
+            run = ahead;
+            blockerSize = view.size;
+        }
+    }
+    return run;
+}
+
+bool FrameScanner::stepOver() {
+    const U32 pending = m_head - m_tail;
+    U32 target = m_head;
+    // Each step passes one held frame, and the run before it if that is too short
+    for (U32 step = 0; step <= MAX_VIEWS; step++) {
+        U32 blockerSize = 0;
+        const U32 run = runFrom(target, m_size - (target - m_head), blockerSize);
+        if (run > pending) {
+            // Ascending order is safe: where the destination wraps onto the source, those bytes were already moved
+            for (U32 i = 0; i < pending; i++) {
+                m_ring[(target + i) & m_mask] = m_ring[(m_tail + i) & m_mask];
+            }
+            const U32 shift = target - m_tail;
+            m_tail += shift;
+            m_head += shift;
+            m_checksumPosition += shift;
+            return true;
+        }
+        if (blockerSize == 0) {
+            return false;
+        }
+        target += run + blockerSize;
+    }
+    return false;
+}
+
+U32 FrameScanner::largestRun(const Frame& frame) const {
+    // Every free run starts at the end of a held frame and ends at the start of the next one
+    U32 largest = 0;
+    for (U32 slot = 0; slot <= MAX_VIEWS; slot++) {
+        if (slot < MAX_VIEWS && !m_views[slot].held) {
+            continue;
+        }
+        const U32 end = (slot < MAX_VIEWS) ? m_views[slot].position + m_views[slot].size : frame.position + frame.size;
+        U32 blockerSize = 0;
+        U32 run = runFrom(end, m_size, blockerSize);
+        const U32 toFrame = (frame.position - end) & m_mask;
+        run = (toFrame < run) ? toFrame : run;
+        largest = (run > largest) ? run : largest;
+    }
+    return largest;
+}
+
+U32 FrameScanner::write(const U8* data, const U32 length) {
+    FW_ASSERT(m_ring != nullptr);
+    reclaim();
+    U32 written = 0;
+    while (written < length) {
+        // Unconsumed bytes are never overwritten, and held frames are stepped over
+        U32 blockerSize = 0;
+        const U32 run = runFrom(m_head, m_size - (m_head - m_tail), blockerSize);
+        if (run == 0) {
+            if (blockerSize == 0 || !stepOver()) {
+                break;
+            }
+            continue;
+        }
+        const U32 remaining = length - written;
+        const U32 count = (remaining < run) ? remaining : run;
+        const U32 index = m_head & m_mask;
+        const U32 first = (count < m_size - index) ? count : m_size - index;
+        (void)memcpy(m_ring + index, data + written, first);
+        (void)memcpy(m_ring, data + written + first, count - first);
+        m_head += count;
+        written += count;
+    }
+    return written;
+}
+
+bool FrameScanner::startsAt(const U32 position) const {
+    return m_ring[position & m_mask] == START_BYTE0 && m_ring[(position + 1) & m_mask] == START_BYTE1 &&
+           m_ring[(position + 2) & m_mask] == static_cast<U8>(START_WORD >> 8) &&
+           m_ring[(position + 3) & m_mask] == static_cast<U8>(START_WORD);
+}
+
+U32 FrameScanner::readU32(const U32 position) const {
+    return (static_cast<U32>(m_ring[position & m_mask]) << 24) |
+           (static_cast<U32>(m_ring[(position + 1) & m_mask]) << 16) |
+           (static_cast<U32>(m_ring[(position + 2) & m_mask]) << 8) |
+           static_cast<U32>(m_ring[(position + 3) & m_mask]);
+}
+
+U32 FrameScanner::findStart(const U32 from, const U32 last) const {
+    U32 position = from;
+    while (position != last) {
+        // Candidates that are contiguous in memory from here
+        const U32 index = position & m_mask;
+        const U32 physical = m_size - index;
+        const U32 run = (last - position < physical) ? last - position : physical;
+        const U8* const base = m_ring + index;
+        U32 i = 0;
+
+        // Match the first two start bytes at 16 offsets at once. The second load reaches one byte further, so it must
+        // stay inside the ring storage; the few candidates it cannot cover fall through to the scalar loop.
+#if defined(__SSE2__)
+        const __m128i byte0 = _mm_set1_epi8(static_cast<char>(START_BYTE0));
+        const __m128i byte1 = _mm_set1_epi8(static_cast<char>(START_BYTE1));
+        for (; i + VECTOR_SIZE <= run && i + VECTOR_SIZE < physical; i += VECTOR_SIZE) {
+            const __m128i at0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + i));
+            const __m128i at1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + i + 1));
+            U32 hits = static_cast<U32>(
+                _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(at0, byte0), _mm_cmpeq_epi8(at1, byte1))));
+            while (hits != 0) {
+                const U32 candidate = position + i + static_cast<U32>(__builtin_ctz(hits));
+                if (startsAt(candidate)) {
+                    return candidate;
+                }
+                hits &= hits - 1;
+            }
+        }
+#elif defined(__aarch64__)
+        const uint8x16_t byte0 = vdupq_n_u8(START_BYTE0);
+        const uint8x16_t byte1 = vdupq_n_u8(START_BYTE1);
+        for (; i + VECTOR_SIZE <= run && i + VECTOR_SIZE < physical; i += VECTOR_SIZE) {
+            const uint8x16_t hits =
+                vandq_u8(vceqq_u8(vld1q_u8(base + i), byte0), vceqq_u8(vld1q_u8(base + i + 1), byte1));
+            if (vmaxvq_u8(hits) == 0) {
+                continue;
+            }
+            for (U32 lane = 0; lane < VECTOR_SIZE; lane++) {
+                if (base[i + lane] == START_BYTE0 && startsAt(position + i + lane)) {
+                    return position + i + lane;
+                }
+            }
+        }
+#endif
+        for (; i < run; i++) {
+            if (base[i] == START_BYTE0 && startsAt(position + i)) {
+                return position + i;
+            }
+        }
+        position += run;
+    }
+    return last;
+}
+
+void FrameScanner::checksum(const U32 from, const U32 to) {
+    const U32 count = to - from;
+    const U32 index = from & m_mask;
+    const U32 first = (count < m_size - index) ? count : m_size - index;
+    m_crc.update(m_ring + index, first);
+    m_crc.update(m_ring, count - first);
+}
+
+bool FrameScanner::next(Frame& frame) {
+    while (true) {
+        const U32 available = m_head - m_tail;
+        switch (m_state) {
+            case SEARCH: {
+                if (available < START_SIZE) {
+                    return false;
+                }
+                // The last three bytes may be the beginning of a start word that is still arriving
+                const U32 last = m_head - (START_SIZE - 1);
+                const U32 found = findStart(m_tail, last);
+                m_bytesDiscarded += found - m_tail;
+                m_tail = found;
+                if (found == last) {
+                    return false;
+                }
+                m_state = HEADER;
+                break;
+            }
+            case HEADER: {
+                if (available < HEADER_SIZE) {
+                    return false;
+                }
+                m_payloadSize = readU32(m_tail + START_SIZE);
+                if (m_payloadSize == 0 || m_payloadSize > m_maxFrameSize - HEADER_SIZE - TRAILER_SIZE) {
+                    // Not a frame after all: skip the false start word and keep looking
+                    m_invalidSizes++;
+                    m_bytesDiscarded++;
+                    m_tail++;
+                    m_state = SEARCH;
+                    break;
+                }
+                m_crc.reset();
+                m_checksumPosition = m_tail;
+                m_state = BODY;
+                break;
+            }
+            case BODY: {
+                // Checksum whatever arrived since the last call, then wait for the rest
+                const U32 checksumEnd = m_tail + HEADER_SIZE + m_payloadSize;
+                const U32 arrived = (available < HEADER_SIZE + m_payloadSize) ? m_head : checksumEnd;
+                checksum(m_checksumPosition, arrived);
+                m_checksumPosition = arrived;
+                if (available < HEADER_SIZE + m_payloadSize + TRAILER_SIZE) {
+                    return false;
+                }
+                if (readU32(checksumEnd) != m_crc.value()) {
+                    m_checksumFailures++;
+                    m_bytesDiscarded++;
+                    m_tail++;
+                    m_state = SEARCH;
+                    break;
+                }
+                frame.position = m_tail;
+                frame.size = HEADER_SIZE + m_payloadSize + TRAILER_SIZE;
+                const U32 index = m_tail & m_mask;
+                frame.data = (index + frame.size <= m_size) ? m_ring + index : nullptr;
+                m_tail += frame.size;
+                m_state = SEARCH;
+                return true;
+            }
+            default:
+                FW_ASSERT(0, m_state);
+                break;
+        }
+    }
+}
+
+bool FrameScanner::hold(const Frame& frame, U32& slot) {
+    // Views released since the last write free their slots here too
+    reclaim();
+    if (frame.data == nullptr || m_viewCount == MAX_VIEWS || largestRun(frame) < m_maxFrameSize) {
+        return false;
+    }
+    slot = 0;
+    while (m_views[slot].held) {
+        slot++;
+    }
+    m_views[slot].position = frame.position;
+    m_views[slot].size = frame.size;
+    m_views[slot].held = true;
+    m_views[slot].released.store(false, std::memory_order_relaxed);
+    m_viewCount++;
+    return true;
+}
+
+void FrameScanner::release(const U32 slot) {
+    FW_ASSERT(slot < MAX_VIEWS, slot);
+    m_views[slot].released.store(true, std::memory_order_release);
+}
+
+void FrameScanner::copy(const Frame& frame, U8* destination) const {
+    const U32 index = frame.position & m_mask;
+    const U32 first = (frame.size < m_size - index) ? frame.size : m_size - index;
+    (void)memcpy(destination, m_ring + index, first);
+    (void)memcpy(destination + first, m_ring, frame.size - first);
+}
+
+}  // namespace FlightComputer
@@ -0,0 +1,119 @@
+#ifndef RINGFRAMEACCUMULATOR_FRAMESCANNER_H_
+#define RINGFRAMEACCUMULATOR_FRAMESCANNER_H_
+
+#include <FlightComputer/Common/Crc32.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+#include <atomic>
+
+namespace FlightComputer {
+
+/**
+ * \brief finds F' frames (start word, U32 size, payload, CRC-32) in a byte stream held in a ring buffer
+ *
+ * Bytes are copied into the ring once and, short of stepping over a held frame, never moved. The start word is
+ * searched with 16 byte vector compares, and a candidate frame's checksum is computed over each piece of payload as it
+ * arrives, so a byte is looked at once however the stream is split up. A frame that does not wrap around the end of
+ * the ring can be held in place and handed out as a view; its space is only reused once it is released, which may
+ * happen on any thread and in any order. Held frames pin only their own bytes: the writer steps over them, moving any
+ * partly received frame past them, so a view kept for a long time does not stall the stream. Everything else is
+ * single-threaded and owned by the writer.
+ */
+class FrameScanner {
+  public:
+    static const U32 START_WORD = 0xDEADBEEF;
+    static const U32 HEADER_SIZE = 8;  //!< Start word and payload size
+    static const U32 TRAILER_SIZE = 4;  //!< CRC-32 over header and payload
+    //! Frames that can be held as views at once
+    static const U32 MAX_VIEWS = 8;
+
+    //! A complete, checksum verified frame including header and trailer
+    struct Frame {
+        const U8* data;  //!< The frame in the ring, or nullptr if it wraps and must be copied out
+        U32 position;  //!< Stream position of the start word
+        U32 size;
+    };
+
+    FrameScanner();
+
+    //! Attach ring storage; size must be a power of two and at least maxFrameSize
+    void setup(U8* storage, const U32 size, const U32 maxFrameSize);
+
+    //! Append up to length bytes; returns how many fit
+    U32 write(const U8* data, const U32 length);
+
+    //! Find the next frame in what has been written so far, consuming it and any noise before it
+    //!
+    //! The frame's bytes stay valid until the next write() unless the frame is held.
+    bool next(Frame& frame);
+
+    //! Keep a contiguous frame in place until release(slot)
+    //!
+    //! False if the frame wraps, every view is in use, or holding it would leave no free run of the ring that fits a
+    //! largest frame, so the stream can always get past what is held.
+    bool hold(const Frame& frame, U32& slot);
+
+    //! Let the space of a held frame be reused. Safe to call from any thread.
+    void release(const U32 slot);
+
+    //! Copy a frame returned by next() out of the ring
+    void copy(const Frame& frame, U8* destination) const;
+
+    U32 bytesDiscarded() const { return m_bytesDiscarded; }
+    U32 checksumFailures() const { return m_checksumFailures; }
+    U32 invalidSizes() const { return m_invalidSizes; }
+
+  private:
+    enum State { SEARCH, HEADER, BODY };
+
+    struct View {
+        U32 position;
+        U32 size;
+        bool held;  //!< Handed out and not yet reclaimed; writer only
+        std::atomic<bool> released;
+    };
+
+    //! First stream position in [from, last) where the start word begins, or last
+    U32 findStart(const U32 from, const U32 last) const;
+
+    bool startsAt(const U32 position) const;
+    U32 readU32(const U32 position) const;
+    void checksum(const U32 from, const U32 to);
+
+    //! Free the slots of released views
+    void reclaim();
+
+    //! Bytes from position up to the start of the nearest held frame, at most limit. blockerSize is the size of that
+    //! frame, or 0 if the limit ended the run.
+    U32 runFrom(const U32 position, const U32 limit, U32& blockerSize) const;
+
+    //! Move the unconsumed bytes past the held frame at the head; false if no free run fits them
+    bool stepOver();
+
+    //! Largest run between held frames, were frame held as well
+    U32 largestRun(const Frame& frame) const;
+
+    U8* m_ring;
+    U32 m_size;
+    U32 m_mask;
+    U32 m_maxFrameSize;
+
+    // Free-running stream positions; only differences are meaningful
+    U32 m_head;  //!< Next position written
+    U32 m_tail;  //!< Start of the data not yet consumed by next()
+
+    State m_state;
+    U32 m_payloadSize;
+    U32 m_checksumPosition;  //!< Bytes of the candidate frame before this are already in m_crc
+    Crc32 m_crc;
+
+    View m_views[MAX_VIEWS];
+    U32 m_viewCount;
+
+    U32 m_bytesDiscarded;
+    U32 m_checksumFailures;
+    U32 m_invalidSizes;
+};
+
+}  // namespace FlightComputer
+
+#endif  // RINGFRAMEACCUMULATOR_FRAMESCANNER_H_
@@ -0,0 +1,166 @@
+// ======================================================================
+// \title  RingFrameAccumulator.cpp
+// \brief  cpp file for RingFrameAccumulator component implementation class
+// ======================================================================
+
+#include <FlightComputer/RingFrameAccumulator/RingFrameAccumulator.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <cstring>
+
+namespace FlightComputer {
+
+  namespace {
+    // Views carry this in the upper half of their context, the view slot in the lower half. Buffer pools put their
+    // id there and Fw::Buffer::NO_CONTEXT is all ones, so neither collides.
+    const U32 VIEW_CONTEXT = 0xFFFE0000;
+    const U32 VIEW_CONTEXT_MASK = 0xFFFF0000;
+  }
+
+  RingFrameAccumulator ::
+    RingFrameAccumulator(
+        const char *const compName
+    ) : RingFrameAccumulatorComponentBase(compName),
+        m_allocator(nullptr),
+        m_allocationId(0),
+        m_ring(nullptr),
+        m_bytesReceived(0),
+        m_framesViewed(0),
+        m_framesCopied(0),
+        m_bytesOverrun(0),
+        m_allocFailures(0)
+  {
+
+  }
+
+  RingFrameAccumulator ::~RingFrameAccumulator() {
+    cleanup();
+  }
+
+  void RingFrameAccumulator ::
+    init(
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    RingFrameAccumulatorComponentBase::init(instance);
+  }
+
+  void RingFrameAccumulator ::
+    configure(
+        const NATIVE_UINT_TYPE allocationId,
+        Fw::MemAllocator& allocator,
+        const U32 ringSize,
+        const U32 maxFrameSize
+    )
+  {
+    FW_ASSERT(m_ring == nullptr);
+    NATIVE_UINT_TYPE allocated = ringSize;
+    bool recoverable = false;
+    m_ring = static_cast<U8*>(allocator.allocate(allocationId, allocated, recoverable));
+    FW_ASSERT(m_ring != nullptr);
+    FW_ASSERT(allocated >= ringSize, allocated, ringSize);
+    // Fault the ring in now rather than on the first uplink
+    (void) memset(m_ring, 0, ringSize);
+
+    m_allocator = &allocator;
+    m_allocationId = allocationId;
+    m_scanner.setup(m_ring, ringSize, maxFrameSize);
+  }
+
+  void RingFrameAccumulator ::cleanup() {
+    if (m_ring != nullptr) {
+      m_allocator->deallocate(m_allocationId, m_ring);
+      m_ring = nullptr;
+    }
+  }
+
+  void RingFrameAccumulator ::emitFrames() {
+    FrameScanner::Frame frame;
+    while (m_scanner.next(frame)) {
+      U32 slot = 0;
+      if (m_scanner.hold(frame, slot)) {
+        // Downstream only reads the frame; the ring keeps it in place until it comes back on frameReturn
+        Fw::Buffer view(const_cast<U8*>(frame.data), frame.size, VIEW_CONTEXT | slot);
+        m_framesViewed++;
+        frameOut_out(0, view);
+        continue;
+      }
+
+      Fw::Buffer buffer = frameAllocate_out(0, frame.size);
+      if (buffer.getData() == nullptr || buffer.getSize() < frame.size) {
+        if (buffer.getData() != nullptr) {
+          frameDeallocate_out(0, buffer);
+        }
+        m_allocFailures++;
+        log_WARNING_HI_FrameAllocFailed(frame.size);
+        continue;
+      }
+      m_scanner.copy(frame, buffer.getData());
+      buffer.setSize(frame.size);
+      m_framesCopied++;
+      frameOut_out(0, buffer);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void RingFrameAccumulator ::
+    dataIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& recvBuffer,
+        const Drv::RecvStatus& recvStatus
+    )
+  {
+    FW_ASSERT(m_ring != nullptr);
+    if (recvStatus == Drv::RecvStatus::RECV_OK && recvBuffer.getData() != nullptr) {
+      const U8* data = recvBuffer.getData();
+      U32 remaining = recvBuffer.getSize();
+      // Parsing between writes frees the space of frames that were consumed (or released) meanwhile
+      while (remaining > 0) {
+        const U32 written = m_scanner.write(data, remaining);
+        if (written == 0) {
+          m_bytesOverrun += remaining;
+          log_WARNING_HI_RingOverrun(remaining);
+          break;
+        }
+        data += written;
+        remaining -= written;
+        m_bytesReceived += written;
+        emitFrames();
+      }
+    }
+    dataDeallocate_out(0, recvBuffer);
+  }
+
+  void RingFrameAccumulator ::
+    frameReturn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    const U32 context = fwBuffer.getContext();
+    if ((context & VIEW_CONTEXT_MASK) == VIEW_CONTEXT) {
+      m_scanner.release(context & ~VIEW_CONTEXT_MASK);
+      return;
+    }
+    frameDeallocate_out(0, fwBuffer);
+  }
+
+  void RingFrameAccumulator ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    tlmWrite_BytesReceived(m_bytesReceived);
+    tlmWrite_FramesViewed(m_framesViewed);
+    tlmWrite_FramesCopied(m_framesCopied);
+    tlmWrite_BytesDiscarded(m_scanner.bytesDiscarded());
+    tlmWrite_ChecksumFailures(m_scanner.checksumFailures());
+    tlmWrite_BytesOverrun(m_bytesOverrun);
+    tlmWrite_AllocFailures(m_allocFailures);
+  }
+
+} // end namespace FlightComputer
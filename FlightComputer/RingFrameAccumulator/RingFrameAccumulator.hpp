@@ -0,0 +1,92 @@
+#ifndef RingFrameAccumulator_HPP
+#define RingFrameAccumulator_HPP
+
+#include "FlightComputer/RingFrameAccumulator/RingFrameAccumulatorComponentAc.hpp"
+#include "FlightComputer/RingFrameAccumulator/FrameScanner.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+#include "Fw/Types/MemAllocator.hpp"
+
+namespace FlightComputer {
+  class RingFrameAccumulator :
+  public RingFrameAccumulatorComponentBase
+  {
+
+    public:
+
+        // ----------------------------------------------------------------------
+        // Construction, initialization, and destruction
+        // ----------------------------------------------------------------------
+
+        //! Construct object RingFrameAccumulator
+        //!
+        RingFrameAccumulator(
+            const char *const compName /*!< The component name*/
+        );
+
+        //! Initialize object RingFrameAccumulator
+        //!
+        void init(
+            const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+        );
+
+        //! Allocate the ring
+        //!
+        //! The ring must hold the largest frame plus any frames still held as views, so a few times maxFrameSize.
+        //!
+        void configure(
+            const NATIVE_UINT_TYPE allocationId, /*!< Identifier passed to the allocator*/
+            Fw::MemAllocator& allocator, /*!< Allocator for the ring*/
+            const U32 ringSize, /*!< Ring size in bytes, a power of two*/
+            const U32 maxFrameSize /*!< Largest frame accepted, header and checksum included*/
+        );
+
+        //! Return the ring to its allocator
+        //!
+        void cleanup();
+
+        //! Destroy object RingFrameAccumulator
+        //!
+        ~RingFrameAccumulator();
+
+    PRIVATE:
+
+        //! Send every complete frame in the ring
+        void emitFrames();
+
+        //! Handler implementation for dataIn
+        //!
+        void dataIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            Fw::Buffer& recvBuffer,
+            const Drv::RecvStatus& recvStatus
+        );
+
+        //! Handler implementation for frameReturn
+        //!
+        void frameReturn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            Fw::Buffer& fwBuffer /*!< The buffer*/
+        );
+
+        //! Handler implementation for schedIn
+        //!
+        void schedIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            NATIVE_UINT_TYPE context /*!< The call order*/
+        );
+
+        FrameScanner m_scanner;
+        Fw::MemAllocator* m_allocator;
+        NATIVE_UINT_TYPE m_allocationId;
+        U8* m_ring;
+
+        U32 m_bytesReceived;
+        U32 m_framesViewed;
+        U32 m_framesCopied;
+        U32 m_bytesOverrun;
+        U32 m_allocFailures;
+
+    };
+
+} // end namespace FlightComputer
+#endif
@@ -0,0 +1,183 @@
+// ======================================================================
+// \title  FrameScanBench.cpp
+// \brief  uplink frame extraction throughput, FrameScanner against the
+//         F' frame detector as Svc.FrameAccumulator drives it
+//
+// Two synthetic streams are cut into receive-sized chunks and fed to
+// both implementations:
+//  - back-to-back: valid frames with no gaps
+//  - noisy: random bytes (with extra 0xDE bytes to provoke false start
+//    words) between frames, and one frame in ten corrupted
+// The reference path mirrors FrameAccumulator::processRing: serialize
+// into a Types::CircularBuffer, detect, rotate one byte on a miss and
+// copy the frame out on a hit.
+//
+// Usage: ./FrameScanBench [stream MB]
+// ======================================================================
+
+#include "FlightComputer/Common/Crc32.hpp"
+#include "FlightComputer/RingFrameAccumulator/FrameScanner.hpp"
+
+#include <Svc/FrameAccumulator/FrameDetector/FprimeFrameDetector.hpp>
+#include <Utils/Types/CircularBuffer.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace FlightComputer;
+
+namespace {
+    const U32 RECV_CHUNK = 1024;  // Bytes per comm receive
+    const U32 REFERENCE_STORE = 2048;  // Accumulation buffer the topology gives Svc.FrameAccumulator
+    const U32 SCANNER_RING = 16384;
+    const U32 MAX_PAYLOAD = 1000;
+
+    U32 s_rng = 0x12345678;
+    U32 random32() {
+        s_rng ^= s_rng << 13;
+        s_rng ^= s_rng >> 17;
+        s_rng ^= s_rng << 5;
+        return s_rng;
+    }
+
+    void put32(std::vector<U8>& out, const U32 value) {
+        out.push_back(static_cast<U8>(value >> 24));
+        out.push_back(static_cast<U8>(value >> 16));
+        out.push_back(static_cast<U8>(value >> 8));
+        out.push_back(static_cast<U8>(value));
+    }
+
+    //! Build a stream of at least size bytes; returns the number of valid frames in it
+    U32 buildStream(std::vector<U8>& stream, const size_t size, const bool noisy) {
+        U32 frames = 0;
+        while (stream.size() < size) {
+            if (noisy) {
+                const U32 gap = random32() % 512;
+                for (U32 i = 0; i < gap; i++) {
+                    stream.push_back((random32() % 64 == 0) ? 0xDE : static_cast<U8>(random32()));
+                }
+            }
+            const size_t start = stream.size();
+            const U32 payload = 16 + random32() % (MAX_PAYLOAD - 16);
+            put32(stream, FrameScanner::START_WORD);
+            put32(stream, payload);
+            for (U32 i = 0; i < payload; i++) {
+                stream.push_back(static_cast<U8>(random32()));
+            }
+            Crc32 crc;
+            crc.update(&stream[start], static_cast<U32>(stream.size() - start));
+            put32(stream, crc.value());
+            if (noisy && random32() % 10 == 0) {
+                stream[start + FrameScanner::HEADER_SIZE] ^= 0x01;
+            } else {
+                frames++;
+            }
+        }
+        return frames;
+    }
+
+    U32 runReference(const std::vector<U8>& stream) {
+        std::vector<U8> store(REFERENCE_STORE);
+        std::vector<U8> frame(REFERENCE_STORE);
+        Types::CircularBuffer ring(store.data(), store.size());
+        Svc::FrameDetectors::FprimeFrameDetector detector;
+        U32 frames = 0;
+
+        for (size_t offset = 0; offset < stream.size(); offset += RECV_CHUNK) {
+            const size_t chunk = (stream.size() - offset < RECV_CHUNK) ? stream.size() - offset : RECV_CHUNK;
+            size_t fed = 0;
+            while (fed < chunk) {
+                FwSizeType space = ring.get_free_size();
+                const FwSizeType count = (chunk - fed < space) ? chunk - fed : space;
+                (void)ring.serialize(&stream[offset + fed], count);
+                fed += count;
+                while (true) {
+                    FwSizeType size = 0;
+                    const Svc::FrameDetector::Status status = detector.detect(ring, size);
+                    if (status == Svc::FrameDetector::Status::FRAME_DETECTED) {
+                        (void)ring.peek(frame.data(), size);
+                        (void)ring.rotate(size);
+                        frames++;
+                    } else if (status == Svc::FrameDetector::Status::NO_FRAME_DETECTED) {
+                        (void)ring.rotate(1);
+                    } else {
+                        break;
+                    }
+                }
+            }
+        }
+        return frames;
+    }
+
+    U32 runScanner(const std::vector<U8>& stream, U32& viewed) {
+        std::vector<U8> ring(SCANNER_RING);
+        std::vector<U8> frame(SCANNER_RING);
+        FrameScanner scanner;
+        scanner.setup(ring.data(), SCANNER_RING, REFERENCE_STORE);
+        U32 frames = 0;
+        viewed = 0;
+
+        for (size_t offset = 0; offset < stream.size(); offset += RECV_CHUNK) {
+            const size_t chunk = (stream.size() - offset < RECV_CHUNK) ? stream.size() - offset : RECV_CHUNK;
+            U32 fed = 0;
+            while (fed < chunk) {
+                fed += scanner.write(&stream[offset + fed], static_cast<U32>(chunk - fed));
+                FrameScanner::Frame found;
+                while (scanner.next(found)) {
+                    U32 slot = 0;
+                    if (scanner.hold(found, slot)) {
+                        // Downstream handles the view synchronously, as the deframer and router do
+                        scanner.release(slot);
+                        viewed++;
+                    } else {
+                        scanner.copy(found, frame.data());
+                    }
+                    frames++;
+                }
+            }
+        }
+        return frames;
+    }
+
+    template <typename Fn>
+    double megabytesPerSecond(const size_t bytes, Fn run) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        run();
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        return static_cast<double>(bytes) / 1e6 / seconds;
+    }
+
+    bool compare(const char* name, const size_t size, const bool noisy) {
+        std::vector<U8> stream;
+        const U32 expected = buildStream(stream, size, noisy);
+        U32 referenceFrames = 0;
+        U32 scannerFrames = 0;
+        U32 viewed = 0;
+        const double referenceMBs = megabytesPerSecond(stream.size(), [&]() { referenceFrames = runReference(stream); });
+        const double scannerMBs = megabytesPerSecond(stream.size(), [&]() { scannerFrames = runScanner(stream, viewed); });
+
+        (void)printf("%s (%zu bytes, %u frames)\n", name, stream.size(), expected);
+        (void)printf("  FprimeFrameDetector: %8.1f MB/s, %u frames\n", referenceMBs, referenceFrames);
+        (void)printf("  FrameScanner:        %8.1f MB/s, %u frames (%u as views)\n", scannerMBs, scannerFrames, viewed);
+        return referenceFrames == expected && scannerFrames == expected;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const unsigned long megabytes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 32UL;
+    if (megabytes == 0) {
+        (void)fprintf(stderr, "Usage: %s [stream MB]\n", argv[0]);
+        return 1;
+    }
+    const size_t size = megabytes * 1024 * 1024;
+    bool ok = compare("back-to-back", size, false);
+    ok = compare("noisy", size, true) && ok;
+    if (!ok) {
+        (void)fprintf(stderr, "Frame counts differ from the stream\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,366 @@
+// ======================================================================
+// \title  FrameScannerTest.cpp
+// \brief  frame detection, resynchronization and view lifetime tests
+//
+// Frames are built the way Svc.Framer builds them and fed to a small
+// ring in pieces, so that frames straddle the end of the ring and the
+// boundaries between writes.
+// ======================================================================
+
+#include "FlightComputer/RingFrameAccumulator/FrameScanner.hpp"
+#include "FlightComputer/Common/Crc32.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace FlightComputer;
+
+namespace {
+    typedef std::vector<U8> Bytes;
+
+    const U32 MAX_FRAME_SIZE = 128;
+
+    void appendU32(Bytes& bytes, const U32 value) {
+        bytes.push_back(static_cast<U8>(value >> 24));
+        bytes.push_back(static_cast<U8>(value >> 16));
+        bytes.push_back(static_cast<U8>(value >> 8));
+        bytes.push_back(static_cast<U8>(value));
+    }
+
+    //! An F' frame around payload
+    Bytes makeFrame(const Bytes& payload) {
+        Bytes frame;
+        appendU32(frame, FrameScanner::START_WORD);
+        appendU32(frame, static_cast<U32>(payload.size()));
+        frame.insert(frame.end(), payload.begin(), payload.end());
+        Crc32 crc;
+        crc.update(frame.data(), static_cast<U32>(frame.size()));
+        appendU32(frame, crc.value());
+        return frame;
+    }
+
+    //! A payload of size bytes identifying frame number, free of start word bytes
+    Bytes makePayload(const U32 number, const U32 size) {
+        Bytes payload(size);
+        for (U32 i = 0; i < size; i++) {
+            payload[i] = static_cast<U8>((number * 7 + i) % 0xD0);
+        }
+        return payload;
+    }
+
+    //! The frame's bytes, copied out of the ring if it wraps
+    Bytes contents(const FrameScanner& scanner, const FrameScanner::Frame& frame) {
+        Bytes bytes(frame.size);
+        if (frame.data != nullptr) {
+            bytes.assign(frame.data, frame.data + frame.size);
+        } else {
+            scanner.copy(frame, bytes.data());
+        }
+        return bytes;
+    }
+
+    //! Feed stream to the scanner in random pieces, collecting every frame found, until it is consumed or stalls
+    std::vector<Bytes> scanAll(FrameScanner& scanner, const Bytes& stream, const U32 seed, U32& wrapped) {
+        std::mt19937 rng(seed);
+        std::vector<Bytes> found;
+        wrapped = 0;
+        U32 offset = 0;
+        while (true) {
+            const size_t before = found.size();
+            FrameScanner::Frame frame;
+            while (scanner.next(frame)) {
+                wrapped += (frame.data == nullptr) ? 1 : 0;
+                found.push_back(contents(scanner, frame));
+            }
+            if (offset == stream.size()) {
+                return found;
+            }
+            const U32 remaining = static_cast<U32>(stream.size()) - offset;
+            const U32 piece = 1 + static_cast<U32>(rng() % 40);
+            const U32 written = scanner.write(stream.data() + offset, (piece < remaining) ? piece : remaining);
+            if (written == 0 && found.size() == before) {
+                return found;
+            }
+            offset += written;
+        }
+    }
+
+    //! Write all of bytes, parsing in between as the accumulator does; returns how many were accepted
+    U32 writeAll(FrameScanner& scanner, const Bytes& bytes) {
+        U32 offset = 0;
+        while (offset < bytes.size()) {
+            const U32 written = scanner.write(bytes.data() + offset, static_cast<U32>(bytes.size()) - offset);
+            if (written == 0) {
+                break;
+            }
+            offset += written;
+            FrameScanner::Frame frame;
+            while (scanner.next(frame)) {
+            }
+        }
+        return offset;
+    }
+}
+
+TEST(FrameScanner, FindsFramesAcrossWritesAndWraparound) {
+    U8 storage[256];
+    FrameScanner scanner;
+    scanner.setup(storage, sizeof(storage), MAX_FRAME_SIZE);
+
+    // Sizes that do not divide the ring, so frames keep landing across its end
+    std::vector<Bytes> frames;
+    Bytes stream;
+    for (U32 number = 0; number < 200; number++) {
+        frames.push_back(makeFrame(makePayload(number, 1 + (number * 13) % 100)));
+        stream.insert(stream.end(), frames.back().begin(), frames.back().end());
+    }
+
+    U32 wrapped = 0;
+    const std::vector<Bytes> found = scanAll(scanner, stream, 1, wrapped);
+    ASSERT_EQ(found.size(), frames.size());
+    for (U32 number = 0; number < frames.size(); number++) {
+        EXPECT_EQ(found[number], frames[number]) << "frame " << number;
+    }
+    EXPECT_GT(wrapped, 0U);
+    EXPECT_EQ(scanner.bytesDiscarded(), 0U);
+    EXPECT_EQ(scanner.checksumFailures(), 0U);
+    EXPECT_EQ(scanner.invalidSizes(), 0U);
+}
+
+TEST(FrameScanner, WrappedFramesCannotBeHeld) {
+    U8 storage[64];
+    FrameScanner scanner;
+    scanner.setup(storage, sizeof(storage), 64);
+
+    // 40 bytes of noise move the second frame across the end of the ring
+    const Bytes noise(40, 0x55);
+    const Bytes first = makeFrame(makePayload(0, 8));
+    const Bytes second = makeFrame(makePayload(1, 20));
+    ASSERT_EQ(scanner.write(noise.data(), static_cast<U32>(noise.size())), noise.size());
+    FrameScanner::Frame frame;
+    EXPECT_FALSE(scanner.next(frame));
+    ASSERT_EQ(scanner.write(first.data(), static_cast<U32>(first.size())), first.size());
+    ASSERT_TRUE(scanner.next(frame));
+    ASSERT_NE(frame.data, nullptr);
+    EXPECT_EQ(contents(scanner, frame), first);
+
+    ASSERT_EQ(scanner.write(second.data(), static_cast<U32>(second.size())), second.size());
+    ASSERT_TRUE(scanner.next(frame));
+    EXPECT_EQ(frame.data, nullptr);
+    EXPECT_EQ(contents(scanner, frame), second);
+    U32 slot = 0;
+    EXPECT_FALSE(scanner.hold(frame, slot));
+    EXPECT_EQ(scanner.bytesDiscarded(), noise.size());
+}
+
+TEST(FrameScanner, ResynchronizesAfterNoiseAndCorruptFrames) {
+    U8 storage[256];
+    FrameScanner scanner;
+    scanner.setup(storage, sizeof(storage), MAX_FRAME_SIZE);
+
+    const Bytes good = makeFrame(makePayload(1, 30));
+    Bytes corrupt = makeFrame(makePayload(2, 30));
+    corrupt[20] ^= 0x01;
+    Bytes oversized;
+    appendU32(oversized, FrameScanner::START_WORD);
+    appendU32(oversized, MAX_FRAME_SIZE);
+    Bytes truncatedStart;
+    appendU32(truncatedStart, FrameScanner::START_WORD);
+    truncatedStart.pop_back();
+
+    const Bytes noise = {0x00, 0xDE, 0xAD, 0x11, 0xDE, 0xAD, 0xBE, 0x00};
+    Bytes stream;
+    const Bytes* const parts[] = {&noise, &good, &corrupt, &truncatedStart, &oversized, &noise, &good};
+    for (const Bytes* part : parts) {
+        stream.insert(stream.end(), part->begin(), part->end());
+    }
+
+    for (U32 seed = 0; seed < 20; seed++) {
+        FrameScanner fresh;
+        fresh.setup(storage, sizeof(storage), MAX_FRAME_SIZE);
+        U32 wrapped = 0;
+        const std::vector<Bytes> found = scanAll(fresh, stream, seed, wrapped);
+        ASSERT_EQ(found.size(), 2U) << "seed " << seed;
+        EXPECT_EQ(found[0], good);
+        EXPECT_EQ(found[1], good);
+        EXPECT_EQ(fresh.checksumFailures(), 1U);
+        EXPECT_EQ(fresh.invalidSizes(), 1U);
+        // Everything but the two good frames is skipped, one byte at a time past each false start
+        EXPECT_EQ(fresh.bytesDiscarded(), stream.size() - 2 * good.size());
+    }
+}
+
+TEST(FrameScanner, ReclaimsReleasedViewsInAnyOrder) {
+    U8 storage[1024];
+    FrameScanner scanner;
+    scanner.setup(storage, sizeof(storage), MAX_FRAME_SIZE);
+
+    // Nine 32 byte frames back to back from the start of the ring, one more than there are views
+    std::vector<Bytes> frames;
+    U32 slots[FrameScanner::MAX_VIEWS + 1];
+    FrameScanner::Frame held[FrameScanner::MAX_VIEWS + 1];
+    for (U32 number = 0; number <= FrameScanner::MAX_VIEWS; number++) {
+        frames.push_back(makeFrame(makePayload(number, 32 - FrameScanner::HEADER_SIZE - FrameScanner::TRAILER_SIZE)));
+        ASSERT_EQ(scanner.write(frames.back().data(), 32), 32U);
+        ASSERT_TRUE(scanner.next(held[number]));
+        EXPECT_EQ(scanner.hold(held[number], slots[number]), number < FrameScanner::MAX_VIEWS) << "frame " << number;
+    }
+
+    // Releasing a view in the middle frees its slot at once
+    const U32 RELEASED = 5;
+    scanner.release(slots[RELEASED]);
+    ASSERT_TRUE(scanner.hold(held[FrameScanner::MAX_VIEWS], slots[FrameScanner::MAX_VIEWS]));
+    EXPECT_EQ(slots[FrameScanner::MAX_VIEWS], slots[RELEASED]);
+
+    // And its bytes: noise streamed through the ring lands there, while every other held frame stays intact
+    const Bytes noise(4 * sizeof(storage), 0x55);
+    EXPECT_EQ(writeAll(scanner, noise), noise.size());
+    for (U32 number = 0; number <= FrameScanner::MAX_VIEWS; number++) {
+        const Bytes bytes(storage + number * 32, storage + (number + 1) * 32);
+        if (number == RELEASED) {
+            EXPECT_EQ(bytes, Bytes(32, 0x55));
+        } else {
+            EXPECT_EQ(bytes, frames[number]) << "frame " << number;
+        }
+    }
+}
+
+TEST(FrameScanner, HoldLeavesRoomForALargestFrame) {
+    U8 storage[256];
+    FrameScanner scanner;
+    scanner.setup(storage, sizeof(storage), MAX_FRAME_SIZE);
+
+    // Four held 32 byte frames leave exactly MAX_FRAME_SIZE free; a fifth would leave less
+    U32 slots[5];
+    FrameScanner::Frame frame;
+    for (U32 number = 0; number < 5; number++) {
+        const Bytes bytes = makeFrame(makePayload(number, 32 - FrameScanner::HEADER_SIZE - FrameScanner::TRAILER_SIZE));
+        ASSERT_EQ(scanner.write(bytes.data(), 32), 32U);
+        ASSERT_TRUE(scanner.next(frame));
+        EXPECT_EQ(scanner.hold(frame, slots[number]), number < 4) << "frame " << number;
+    }
+
+    // Releasing the first joins its space to the free run after the fifth
+    scanner.release(slots[0]);
+    EXPECT_TRUE(scanner.hold(frame, slots[4]));
+}
+
+TEST(FrameScanner, HeldViewDoesNotStallTheStream) {
+    U8 storage[256];
+    FrameScanner scanner;
+    scanner.setup(storage, sizeof(storage), MAX_FRAME_SIZE);
+
+    // A largest frame is held and never released
+    const Bytes pinned = makeFrame(makePayload(1000, MAX_FRAME_SIZE - FrameScanner::HEADER_SIZE - FrameScanner::TRAILER_SIZE));
+    ASSERT_EQ(scanner.write(pinned.data(), static_cast<U32>(pinned.size())), pinned.size());
+    FrameScanner::Frame frame;
+    ASSERT_TRUE(scanner.next(frame));
+    U32 slot = 0;
+    ASSERT_TRUE(scanner.hold(frame, slot));
+    const FrameScanner::Frame view = frame;
+
+    // Many times the ring streams past it, with frames up to the largest so partial ones must be moved around it
+    std::vector<Bytes> frames;
+    Bytes stream;
+    for (U32 number = 0; number < 200; number++) {
+        const U32 size = 1 + (number * 13) % (MAX_FRAME_SIZE - FrameScanner::HEADER_SIZE - FrameScanner::TRAILER_SIZE);
+        frames.push_back(makeFrame(makePayload(number, size)));
+        stream.insert(stream.end(), frames.back().begin(), frames.back().end());
+    }
+    ASSERT_GT(stream.size(), 20 * sizeof(storage));
+
+    U32 wrapped = 0;
+    const std::vector<Bytes> found = scanAll(scanner, stream, 3, wrapped);
+    ASSERT_EQ(found.size(), frames.size());
+    for (U32 number = 0; number < frames.size(); number++) {
+        EXPECT_EQ(found[number], frames[number]) << "frame " << number;
+    }
+    EXPECT_EQ(scanner.bytesDiscarded(), 0U);
+    EXPECT_EQ(scanner.checksumFailures(), 0U);
+    EXPECT_EQ(Bytes(view.data, view.data + view.size), pinned);
+}
+
+TEST(FrameScanner, HeldViewsSurviveUntilReleasedOnAnotherThread) {
+    U8 storage[1024];
+    FrameScanner scanner;
+    scanner.setup(storage, sizeof(storage), MAX_FRAME_SIZE);
+
+    // Held frames go to a consumer thread that checks and releases them in order, as downstream returns views.
+    // Frames that cannot be held are checked here, where the accumulator would copy them out.
+    struct Handoff {
+        FrameScanner::Frame frame;
+        U32 slot;
+        U32 number;
+    };
+    const U32 FRAMES = 5000;
+    Handoff handoffs[FrameScanner::MAX_VIEWS];
+    std::atomic<U32> handed(0);
+    std::atomic<U32> consumed(0);
+    std::atomic<bool> done(false);
+    std::atomic<U32> mismatches(0);
+
+    std::thread consumer([&]() {
+        U32 taken = 0;
+        while (true) {
+            if (taken == handed.load(std::memory_order_acquire)) {
+                if (done.load(std::memory_order_acquire) && taken == handed.load(std::memory_order_acquire)) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            const Handoff& handoff = handoffs[taken % FrameScanner::MAX_VIEWS];
+            const Bytes expected = makeFrame(makePayload(handoff.number, 1 + handoff.number % 80));
+            if (Bytes(handoff.frame.data, handoff.frame.data + handoff.frame.size) != expected) {
+                mismatches.fetch_add(1);
+            }
+            scanner.release(handoff.slot);
+            consumed.store(++taken, std::memory_order_release);
+        }
+    });
+
+    U32 number = 0;
+    U32 copied = 0;
+    Bytes pending;
+    U32 offset = 0;
+    for (U32 written = 0; number < FRAMES;) {
+        if (offset == pending.size() && written < FRAMES) {
+            pending = makeFrame(makePayload(written, 1 + written % 80));
+            offset = 0;
+            written++;
+        }
+        offset += scanner.write(pending.data() + offset, static_cast<U32>(pending.size()) - offset);
+
+        FrameScanner::Frame frame;
+        while (scanner.next(frame)) {
+            const U32 slotsBusy = handed.load(std::memory_order_relaxed) - consumed.load(std::memory_order_acquire);
+            Handoff& handoff = handoffs[handed.load(std::memory_order_relaxed) % FrameScanner::MAX_VIEWS];
+            if (slotsBusy < FrameScanner::MAX_VIEWS && scanner.hold(frame, handoff.slot)) {
+                handoff.frame = frame;
+                handoff.number = number;
+                handed.fetch_add(1, std::memory_order_release);
+            } else {
+                copied++;
+                if (contents(scanner, frame) != makeFrame(makePayload(number, 1 + number % 80))) {
+                    mismatches.fetch_add(1);
+                }
+            }
+            number++;
+        }
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    EXPECT_EQ(mismatches.load(), 0U);
+    EXPECT_GT(handed.load(), 0U);
+    EXPECT_EQ(handed.load() + copied, FRAMES);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
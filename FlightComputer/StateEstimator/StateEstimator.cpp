@@ -0,0 +1,228 @@
+// ======================================================================
+// \title  StateEstimator.cpp
+// \brief  cpp file for StateEstimator component implementation class
+// ======================================================================
+
+#include <FlightComputer/StateEstimator/StateEstimator.hpp>
+#include "FlightComputer/StateEstimator/FppConstantsAc.hpp"
+#include <Fw/Types/Assert.hpp>
+#include <cmath>
+
+namespace FlightComputer {
+
+  namespace {
+    const F32 TWO_PI = 6.2831853f;
+    // Random walk allowed on the accelerometer bias state per second
+    const F32 BIAS_DRIFT_MSS = 0.01f;
+    // Weight of each new interval in the running estimate of the truth period
+    const F32 TRUTH_PERIOD_GAIN = 0.125f;
+  }
+
+  StateEstimator ::
+    StateEstimator(
+        const char *const compName
+    ) : StateEstimatorComponentBase(compName),
+        m_dtS(0.0f),
+        m_steps(0),
+        m_rngState(0x9E3779B9u),
+        m_droppedSteps(0),
+        m_droppedStepsApplied(0),
+        m_resetPending(false),
+        m_truthLock(),
+        m_truthAltitudeM(0.0f),
+        m_truthVelocityMS(0.0f),
+        m_truthAccelMSS(0.0f),
+        m_truthFresh(false),
+        m_truthSeen(false),
+        m_truthAgeSteps(0),
+        m_truthPeriodS(static_cast<F32>(StateEstimator_truthPeriodS))
+  {
+
+  }
+
+  StateEstimator ::~StateEstimator() {}
+
+  void StateEstimator ::
+    init(
+        const NATIVE_INT_TYPE queueDepth,
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    StateEstimatorComponentBase::init(queueDepth, instance);
+  }
+
+  void StateEstimator ::configure(const F32 dtS) {
+    FW_ASSERT(dtS > 0.0f);
+    m_dtS = dtS;
+    setupModel(m_filter, dtS);
+  }
+
+  void StateEstimator ::setupModel(Filter& filter, const F32 dtS) {
+    const F32 halfDt2 = 0.5f * dtS * dtS;
+
+    // Constant acceleration kinematics driven by the bias corrected accelerometer
+    filter.F = Filter::StateMat::identity();
+    filter.F(0, 1) = dtS;
+    filter.F(0, 2) = -halfDt2;
+    filter.F(1, 2) = -dtS;
+
+    filter.B = Matrix<F32, 3, 1>::zeros();
+    filter.B[0] = halfDt2;
+    filter.B[1] = dtS;
+
+    // Accelerometer noise enters through B, bias drifts as a random walk
+    const F32 accelVar = static_cast<F32>(StateEstimator_accelStdMSS * StateEstimator_accelStdMSS);
+    filter.Q = filter.B * filter.B.transpose() * accelVar;
+    filter.Q(2, 2) = BIAS_DRIFT_MSS * BIAS_DRIFT_MSS * dtS;
+
+    filter.H = Matrix<F32, 1, 3>::zeros();
+    filter.H(0, 0) = 1.0f;
+    filter.R(0, 0) = static_cast<F32>(StateEstimator_altimeterStdM * StateEstimator_altimeterStdM);
+
+    Filter::StateMat P0 = Filter::StateMat::identity();
+    P0(0, 0) = filter.R(0, 0);
+    filter.reset(Filter::StateVec::zeros(), P0);
+  }
+
+  F32 StateEstimator ::gaussian() {
+    // xorshift32 feeding a Box-Muller transform
+    F32 u[2];
+    for (U32 i = 0; i < 2; i++) {
+      m_rngState ^= m_rngState << 13;
+      m_rngState ^= m_rngState >> 17;
+      m_rngState ^= m_rngState << 5;
+      u[i] = (static_cast<F32>(m_rngState >> 8) + 1.0f) * (1.0f / 16777217.0f);
+    }
+    return std::sqrt(-2.0f * std::log(u[0])) * std::cos(TWO_PI * u[1]);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void StateEstimator ::
+    truthIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        F32 altitudeM,
+        F32 velocityMS,
+        F32 accelMSS
+    )
+  {
+    FC_TRACE_SCOPE("port", "StateEstimator.truthIn");
+    m_truthLock.lock();
+    m_truthAltitudeM = altitudeM;
+    m_truthVelocityMS = velocityMS;
+    m_truthAccelMSS = accelMSS;
+    m_truthFresh = true;
+    m_truthLock.unLock();
+  }
+
+  void StateEstimator ::
+    resetIn_handler(
+        const NATIVE_INT_TYPE portNum
+    )
+  {
+    FC_TRACE_SCOPE("port", "StateEstimator.resetIn");
+    m_resetPending.store(true);
+  }
+
+  void StateEstimator ::run_preMsgHook(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+    FC_TRACE_ENQUEUE(m_queueFlow, "queue", "StateEstimator");
+  }
+
+  void StateEstimator ::run_overflowHook(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+    FC_TRACE_DROP(m_queueFlow, "queue", "StateEstimator");
+    m_droppedSteps.fetch_add(1);
+  }
+
+  void StateEstimator ::
+    run_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    FC_TRACE_SCOPE("port", "StateEstimator.run");
+    FC_TRACE_DISPATCH(m_queueFlow, "queue", "StateEstimator");
+    FW_ASSERT(m_dtS > 0.0f);
+
+    // The filter belongs to this thread, so a reset requested from the sequencer's thread is applied here
+    if (m_resetPending.exchange(false)) {
+      setupModel(m_filter, m_dtS);
+    }
+
+    // Steps dropped by a full queue still elapsed, so the filter and the truth propagation advance over them too
+    const U32 dropped = m_droppedSteps.load();
+    const U32 missed = dropped - m_droppedStepsApplied;
+    m_droppedStepsApplied = dropped;
+
+    m_truthLock.lock();
+    if (m_truthFresh) {
+      // The sequencer's run is driven from more than one rate group, so samples come at uneven intervals. Their mean
+      // is measured on the estimator's own clock, the one the propagation below runs on. An interval is capped at two
+      // periods so a pause in the flight does not swamp the estimate.
+      if (m_truthSeen) {
+        const F32 intervalS = static_cast<F32>(m_truthAgeSteps + 1 + missed) * m_dtS;
+        const F32 cappedS = (intervalS < 2.0f * m_truthPeriodS) ? intervalS : 2.0f * m_truthPeriodS;
+        m_truthPeriodS += TRUTH_PERIOD_GAIN * (cappedS - m_truthPeriodS);
+      }
+      m_truthSeen = true;
+      m_truthFresh = false;
+      m_truthAgeSteps = 0;
+    } else {
+      m_truthAgeSteps += 1 + missed;
+    }
+    const F32 sampleAltitudeM = m_truthAltitudeM;
+    const F32 sampleVelocityMS = m_truthVelocityMS;
+    const F32 sampleAccelMSS = m_truthAccelMSS;
+    m_truthLock.unLock();
+
+    // Truth only arrives every period or so, so it is propagated at constant acceleration in between for the sensors
+    // to see a smooth trajectory. The sequencer integrates with semi-implicit Euler: its velocity is the mean over the
+    // period ending at the sample, i.e. half a period behind its altitude. Advancing the velocity by half a period
+    // makes the propagated curve pass through every sample while the acceleration holds. A sample not replaced within
+    // two periods (the sequencer stopped updating) is held at rest where the propagation got to.
+    const F32 periodS = m_truthPeriodS;
+    const F32 ageS = static_cast<F32>(m_truthAgeSteps) * m_dtS;
+    const bool stale = ageS > 2.0f * periodS;
+    const F32 spanS = stale ? 2.0f * periodS : ageS;
+    const F32 startVelocityMS = sampleVelocityMS + 0.5f * sampleAccelMSS * periodS;
+    const F32 truthAltitudeM = sampleAltitudeM + startVelocityMS * spanS + 0.5f * sampleAccelMSS * spanS * spanS;
+    const F32 truthAccelMSS = stale ? 0.0f : sampleAccelMSS;
+
+    // Simulated accelerometer drives the prediction every step
+    Matrix<F32, 1, 1> accel;
+    for (U32 step = 0; step <= missed; step++) {
+      accel[0] = truthAccelMSS + static_cast<F32>(StateEstimator_accelBiasMSS) +
+                 static_cast<F32>(StateEstimator_accelStdMSS) * gaussian();
+      m_filter.predict(accel);
+    }
+
+    // Simulated altimeter runs slower than the filter
+    Matrix<F32, 1, 1> innovation = Matrix<F32, 1, 1>::zeros();
+    const bool altimeterStep = (m_steps % StateEstimator_altimeterDecimation) == 0;
+    if (altimeterStep) {
+      Matrix<F32, 1, 1> altitude;
+      altitude[0] = truthAltitudeM + static_cast<F32>(StateEstimator_altimeterStdM) * gaussian();
+      if (!m_filter.update(altitude, innovation)) {
+        log_WARNING_LO_MeasurementRejected(altitude[0]);
+      }
+    }
+
+    const Filter::StateVec& x = m_filter.x;
+    if (isConnected_estimateOut_OutputPort(0)) {
+      estimateOut_out(0, x[0], x[1], m_filter.P(0, 0));
+    }
+
+    if ((m_steps % StateEstimator_tlmDecimation) == 0) {
+      StateEstimator_estimate est(x[0], x[1], x[2], std::sqrt(m_filter.P(0, 0)));
+      tlmWrite_stateEstimate(est);
+      tlmWrite_stepCount(m_steps);
+      tlmWrite_droppedSteps(dropped);
+      if (altimeterStep) {
+        tlmWrite_altitudeInnovationM(innovation[0]);
+      }
+    }
+    m_steps++;
+  }
+
+} // end namespace FlightComputer
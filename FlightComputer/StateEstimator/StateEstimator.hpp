@@ -0,0 +1,111 @@
+#ifndef StateEstimator_HPP
+#define StateEstimator_HPP
+
+#include "FlightComputer/Common/KalmanFilter.hpp"
+#include "FlightComputer/StateEstimator/StateEstimatorComponentAc.hpp"
+#include "FlightComputer/StateEstimator/StateEstimator_estimateSerializableAc.hpp"
+#include "FlightComputer/Trace/Trace.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+#include "Os/Mutex.hpp"
+#include <atomic>
+
+namespace FlightComputer {
+  class StateEstimator :
+  public StateEstimatorComponentBase
+  {
+
+    public:
+
+        //! Filter layout: state [altitude, velocity, accel bias], altimeter measurement, accelerometer control input
+        typedef KalmanFilter<F32, 3, 1, 1> Filter;
+
+        // ----------------------------------------------------------------------
+        // Construction, initialization, and destruction
+        // ----------------------------------------------------------------------
+
+        //! Construct object StateEstimator
+        //!
+        StateEstimator(
+            const char *const compName /*!< The component name*/
+        );
+
+        //! Initialize object StateEstimator
+        //!
+        void init(
+            const NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
+            const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+        );
+
+        //! Set the estimator step period. Must match the rate of the group driving the run port.
+        //!
+        void configure(
+            const F32 dtS /*!< Step period in seconds*/
+        );
+
+        //! Destroy object StateEstimator
+        //!
+        ~StateEstimator();
+
+    PRIVATE:
+
+        Filter m_filter;
+        F32 m_dtS;
+        U32 m_steps;
+        U32 m_rngState;
+
+        //! Run calls dropped because the queue was full, counted on the caller's thread
+        std::atomic<U32> m_droppedSteps;
+        U32 m_droppedStepsApplied; //!< Dropped steps the filter has already advanced over
+
+        //! Set by resetIn on the caller's thread, cleared by the run that restarts the filter
+        std::atomic<bool> m_resetPending;
+
+        // Latest truth from the flight sequencer, written from its thread
+        Os::Mutex m_truthLock;
+        F32 m_truthAltitudeM;
+        F32 m_truthVelocityMS;
+        F32 m_truthAccelMSS;
+        bool m_truthFresh; //!< Set by truthIn, cleared once run picks the sample up
+        bool m_truthSeen; //!< A sample has been picked up, so the next one measures an interval; run only
+        U32 m_truthAgeSteps; //!< Steps since the current truth sample, run only
+        F32 m_truthPeriodS; //!< Running mean of the interval between truth samples, run only
+
+        // Pairs queued run calls with their dispatch in traces
+        Trace::QueueFlow m_queueFlow;
+
+        //! Populate the filter's model matrices for a given step period
+        //!
+        static void setupModel(Filter& filter, const F32 dtS);
+
+        //! Draw a zero mean, unit variance sample without touching the heap or libc rand state
+        F32 gaussian();
+
+        void run_preMsgHook(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context);
+        void run_overflowHook(const NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context);
+
+        //! Handler implementation for run
+        //!
+        void run_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            NATIVE_UINT_TYPE context /*!< The call order*/
+        );
+
+        //! Handler implementation for truthIn
+        //!
+        void truthIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            F32 altitudeM,
+            F32 velocityMS,
+            F32 accelMSS
+        );
+
+        //! Handler implementation for resetIn
+        //!
+        void resetIn_handler(
+            const NATIVE_INT_TYPE portNum /*!< The port number*/
+        );
+
+    };
+
+} // end namespace FlightComputer
+#endif
@@ -0,0 +1,90 @@
+// ======================================================================
+// \title  KalmanBench.cpp
+// \brief  measures the per-step cost of the estimator's Kalman filter
+//
+// The filter mirrors StateEstimator's layout (3 states, 1 measurement,
+// 1 control input) in single precision. Only the header-only matrix
+// kernels are exercised so the numbers reflect the math alone.
+//
+// Usage: ./KalmanBench [steps]
+// ======================================================================
+
+#include "FlightComputer/Common/KalmanFilter.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace FlightComputer;
+
+namespace {
+    typedef KalmanFilter<float, 3, 1, 1> Filter;
+
+    // Keeps the optimizer from discarding the filter output
+    volatile float sink;
+
+    void setup(Filter& filter, const float dt) {
+        filter.F(0, 1) = dt;
+        filter.F(0, 2) = -0.5f * dt * dt;
+        filter.F(1, 2) = -dt;
+        filter.B[0] = 0.5f * dt * dt;
+        filter.B[1] = dt;
+        filter.Q = filter.B * filter.B.transpose() * 0.25f;
+        filter.Q(2, 2) = 1e-6f;
+        filter.H(0, 0) = 1.0f;
+        filter.R(0, 0) = 4.0f;
+    }
+
+    template <typename Fn>
+    double nsPerStep(const unsigned long steps, Fn step) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned long i = 0; i < steps; i++) {
+            step(i);
+        }
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+               static_cast<double>(steps);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const unsigned long steps = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000UL;
+    if (steps == 0) {
+        (void) fprintf(stderr, "Usage: %s [steps]\n", argv[0]);
+        return 1;
+    }
+
+    Filter filter;
+    setup(filter, 0.005f);
+    Matrix<float, 1, 1> u = {{10.0f}};
+    Matrix<float, 1, 1> z = {{0.0f}};
+    Matrix<float, 1, 1> innovation;
+
+    const double predictNs = nsPerStep(steps, [&](unsigned long i) {
+        u[0] = 10.0f + static_cast<float>(i & 0xF) * 0.01f;
+        filter.predict(u);
+        sink = filter.x[0];
+    });
+
+    filter.reset(Filter::StateVec::zeros(), Filter::StateMat::identity());
+    const double updateNs = nsPerStep(steps, [&](unsigned long i) {
+        z[0] = static_cast<float>(i & 0xFF);
+        filter.update(z, innovation);
+        sink = filter.x[0];
+    });
+
+    filter.reset(Filter::StateVec::zeros(), Filter::StateMat::identity());
+    const double stepNs = nsPerStep(steps, [&](unsigned long i) {
+        filter.predict(u);
+        z[0] = static_cast<float>(i & 0xFF);
+        filter.update(z, innovation);
+        sink = filter.x[0];
+    });
+
+    (void) printf("KalmanFilter<3,1,1> over %lu steps\n", steps);
+    (void) printf("  predict:          %8.1f ns/step\n", predictNs);
+    (void) printf("  update:           %8.1f ns/step\n", updateNs);
+    (void) printf("  predict + update: %8.1f ns/step (%.4f%% of a 200 Hz cycle)\n", stepNs,
+                  stepNs / 5e6 * 100.0);
+    return 0;
+}
@@ -0,0 +1,150 @@
+// ======================================================================
+// \title  KalmanFilterTest.cpp
+// \brief  convergence tests of the estimator's Kalman filter
+//
+// The filter is set up with StateEstimator's layout and noise model
+// (altitude, velocity and accelerometer bias states, a decimated
+// altimeter and an accelerometer control input) and run against an
+// exact constant acceleration trajectory.
+// ======================================================================
+
+#include "FlightComputer/Common/KalmanFilter.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+using namespace FlightComputer;
+
+namespace {
+    typedef KalmanFilter<F32, 3, 1, 1> Filter;
+
+    const F32 DT_S = 0.005f;
+    const U32 ALTIMETER_DECIMATION = 10;
+    const F32 ALTIMETER_STD_M = 2.0f;
+    const F32 ACCEL_STD_MSS = 0.5f;
+    const F32 ACCEL_BIAS_MSS = 0.2f;
+    const F32 BIAS_DRIFT_MSS = 0.01f;
+
+    // Truth: constant acceleration from a non-zero altitude and velocity
+    const F64 ALTITUDE0_M = 100.0;
+    const F64 VELOCITY0_MS = 5.0;
+    const F64 ACCEL_MSS = 12.0;
+
+    void setupModel(Filter& filter) {
+        const F32 halfDt2 = 0.5f * DT_S * DT_S;
+        filter.F = Filter::StateMat::identity();
+        filter.F(0, 1) = DT_S;
+        filter.F(0, 2) = -halfDt2;
+        filter.F(1, 2) = -DT_S;
+        filter.B = Matrix<F32, 3, 1>::zeros();
+        filter.B[0] = halfDt2;
+        filter.B[1] = DT_S;
+        filter.Q = filter.B * filter.B.transpose() * (ACCEL_STD_MSS * ACCEL_STD_MSS);
+        filter.Q(2, 2) = BIAS_DRIFT_MSS * BIAS_DRIFT_MSS * DT_S;
+        filter.H = Matrix<F32, 1, 3>::zeros();
+        filter.H(0, 0) = 1.0f;
+        filter.R(0, 0) = ALTIMETER_STD_M * ALTIMETER_STD_M;
+
+        Filter::StateMat P0 = Filter::StateMat::identity();
+        P0(0, 0) = filter.R(0, 0);
+        filter.reset(Filter::StateVec::zeros(), P0);
+    }
+
+    F64 truthAltitude(const F64 t) {
+        return ALTITUDE0_M + VELOCITY0_MS * t + 0.5 * ACCEL_MSS * t * t;
+    }
+
+    F64 truthVelocity(const F64 t) {
+        return VELOCITY0_MS + ACCEL_MSS * t;
+    }
+
+    //! Run the filter for steps steps. Sensor noise is scaled by noiseScale (0 for perfect sensors).
+    //! Returns the mean over the last half of the run of the squared altitude error normalized by its variance.
+    F64 run(Filter& filter, const U32 steps, const F32 noiseScale) {
+        std::mt19937 rng(1234);
+        std::normal_distribution<F32> unit(0.0f, 1.0f);
+        Matrix<F32, 1, 1> accel;
+        Matrix<F32, 1, 1> altitude;
+        Matrix<F32, 1, 1> innovation;
+        F64 nees = 0.0;
+        U32 neesSamples = 0;
+
+        for (U32 step = 1; step <= steps; step++) {
+            const F64 t = step * static_cast<F64>(DT_S);
+            accel[0] = static_cast<F32>(ACCEL_MSS) + ACCEL_BIAS_MSS + noiseScale * ACCEL_STD_MSS * unit(rng);
+            filter.predict(accel);
+            if (step % ALTIMETER_DECIMATION == 0) {
+                altitude[0] = static_cast<F32>(truthAltitude(t)) + noiseScale * ALTIMETER_STD_M * unit(rng);
+                EXPECT_TRUE(filter.update(altitude, innovation));
+            }
+            if (step > steps / 2) {
+                const F64 error = filter.x[0] - truthAltitude(t);
+                nees += error * error / filter.P(0, 0);
+                neesSamples++;
+            }
+        }
+        return nees / neesSamples;
+    }
+}
+
+TEST(KalmanFilter, ConvergesWithPerfectSensors) {
+    Filter filter;
+    setupModel(filter);
+    // Start 100 m, 5 m/s and the whole bias off
+    const U32 steps = 6000;
+    (void) run(filter, steps, 0.0f);
+
+    const F64 t = steps * static_cast<F64>(DT_S);
+    EXPECT_NEAR(filter.x[0], truthAltitude(t), 0.05);
+    EXPECT_NEAR(filter.x[1], truthVelocity(t), 0.05);
+    EXPECT_NEAR(filter.x[2], ACCEL_BIAS_MSS, 0.02);
+}
+
+TEST(KalmanFilter, ConvergesWithNoisySensors) {
+    Filter filter;
+    setupModel(filter);
+    const U32 steps = 6000;
+    const F64 nees = run(filter, steps, 1.0f);
+
+    // The estimate settles well inside the altimeter noise
+    const F64 t = steps * static_cast<F64>(DT_S);
+    EXPECT_NEAR(filter.x[0], truthAltitude(t), 1.0);
+    EXPECT_NEAR(filter.x[1], truthVelocity(t), 0.5);
+    EXPECT_NEAR(filter.x[2], ACCEL_BIAS_MSS, 0.15);
+    EXPECT_LT(filter.P(0, 0), ALTIMETER_STD_M * ALTIMETER_STD_M);
+
+    // The reported covariance matches the actual error: normalized squared error near 1 on average
+    EXPECT_GT(nees, 0.3);
+    EXPECT_LT(nees, 3.0);
+}
+
+TEST(KalmanFilter, CovarianceStaysSymmetric) {
+    Filter filter;
+    setupModel(filter);
+    (void) run(filter, 6000, 1.0f);
+    for (U32 r = 0; r < 3; r++) {
+        EXPECT_GT(filter.P(r, r), 0.0f);
+        for (U32 c = 0; c < r; c++) {
+            EXPECT_NEAR(filter.P(r, c), filter.P(c, r), 1e-6f);
+        }
+    }
+}
+
+TEST(Matrix, BuildsAtCompileTime) {
+    constexpr Matrix<F32, 2, 2> I = Matrix<F32, 2, 2>::identity();
+    constexpr Matrix<F32, 2, 1> v = {{1.0f, 2.0f}};
+    constexpr Matrix<F32, 2, 1> w = (I * v + v - Matrix<F32, 2, 1>::filled(1.0f)) * 2.0f;
+    static_assert(w[0] == 2.0f && w[1] == 6.0f, "constexpr arithmetic");
+    constexpr Matrix<F32, 1, 2> vt = v.transpose();
+    static_assert(vt(0, 1) == 2.0f, "constexpr transpose");
+    constexpr Matrix<F32, 3, 3> Z = Matrix<F32, 3, 3>::zeros();
+    static_assert(Z(2, 1) == 0.0f, "constexpr zeros");
+    EXPECT_EQ(w[1], 6.0f);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
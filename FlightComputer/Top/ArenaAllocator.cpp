@@ -0,0 +1,43 @@
+#include <FlightComputer/Top/ArenaAllocator.hpp>
+#include <Fw/Logger/Logger.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <unistd.h>
+
+namespace FlightComputer {
+
+ArenaAllocator::ArenaAllocator(U8* storage, const NATIVE_UINT_TYPE size)
+    : m_storage(storage), m_size(size), m_used(0), m_fallback() {
+    FW_ASSERT(storage != nullptr);
+}
+
+ArenaAllocator::~ArenaAllocator() {}
+
+void ArenaAllocator::prefault() {
+    const long page = sysconf(_SC_PAGESIZE);
+    const NATIVE_UINT_TYPE stride = (page > 0) ? static_cast<NATIVE_UINT_TYPE>(page) : 4096;
+    for (NATIVE_UINT_TYPE offset = 0; offset < m_size; offset += stride) {
+        // volatile so the compiler cannot drop stores it believes are dead
+        static_cast<volatile U8*>(m_storage)[offset] = 0;
+    }
+}
+
+void* ArenaAllocator::allocate(const NATIVE_UINT_TYPE identifier, NATIVE_UINT_TYPE& size, bool& recoverable) {
+    recoverable = false;
+    const NATIVE_UINT_TYPE start = (m_used + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (start > m_size || size > m_size - start) {
+        Fw::Logger::log("Arena exhausted for id %u (%u bytes), falling back to malloc\n", identifier, size);
+        return m_fallback.allocate(identifier, size, recoverable);
+    }
+    m_used = start + size;
+    return m_storage + start;
+}
+
+void ArenaAllocator::deallocate(const NATIVE_UINT_TYPE identifier, void* ptr) {
+    U8* const bytes = static_cast<U8*>(ptr);
+    if (bytes >= m_storage && bytes < m_storage + m_size) {
+        return;
+    }
+    m_fallback.deallocate(identifier, ptr);
+}
+
+}  // namespace FlightComputer
@@ -0,0 +1,42 @@
+#ifndef ARENAALLOCATOR_H_
+#define ARENAALLOCATOR_H_
+
+#include <Fw/Types/MallocAllocator.hpp>
+#include <Fw/Types/MemAllocator.hpp>
+
+namespace FlightComputer {
+
+/**
+ * \brief bump allocator over caller supplied storage that can be pre-faulted off the critical path
+ *
+ * Static (.bss) storage is not backed by physical pages until first written, so the first buffers handed out at
+ * runtime would each take a page fault. prefault() writes every page of the arena and is safe to run on a helper
+ * thread while the topology is being initialized, as long as it is joined before the first allocate() call.
+ *
+ * Requests that do not fit in the remaining arena fall back to the malloc allocator so a mis-sized arena costs
+ * performance rather than availability. Memory handed out from the arena is only reclaimed when the arena is.
+ */
+class ArenaAllocator : public Fw::MemAllocator {
+  public:
+    ArenaAllocator(U8* storage, const NATIVE_UINT_TYPE size);
+    ~ArenaAllocator();
+
+    //! Write every page of the arena so later accesses do not fault
+    void prefault();
+
+    void* allocate(const NATIVE_UINT_TYPE identifier, NATIVE_UINT_TYPE& size, bool& recoverable);
+    void deallocate(const NATIVE_UINT_TYPE identifier, void* ptr);
+
+  private:
+    //! Alignment of every block handed out, one cache line
+    static const NATIVE_UINT_TYPE ALIGNMENT = 64;
+
+    U8* const m_storage;
+    const NATIVE_UINT_TYPE m_size;
+    NATIVE_UINT_TYPE m_used;
+    Fw::MallocAllocator m_fallback;
+};
+
+}  // namespace FlightComputer
+
+#endif  // ARENAALLOCATOR_H_
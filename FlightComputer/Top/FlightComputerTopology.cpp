@@ -5,17 +5,24 @@
 #include <FlightComputer/Top/FlightComputerTopologyAc.hpp>
 #include <FlightComputer/Top/FlightComputerTopologyDefs.hpp>
 #include <FlightComputer/Top/FlightComputerTopology.hpp>
+#include <FlightComputer/Top/ArenaAllocator.hpp>
+#include <FlightComputer/Top/StartupProfiler.hpp>
 
 // Necessary project-specified types
 #include <Fw/Types/MallocAllocator.hpp>
+#include <Fw/FilePacket/FilePacket.hpp>
 #include <Os/Console.hpp>
 #include <Svc/FramingProtocol/FprimeProtocol.hpp>
-#include <Svc/FrameAccumulator/FrameDetector/FprimeFrameDetector.hpp>
+#include <Utils/Hash/Hash.hpp>
 
 // Used for 1Hz synthetic cycling
+#include <Fw/Types/Assert.hpp>
 #include <Os/Mutex.hpp>
+#include <Os/Task.hpp>
+#include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <time.h>
 
 // Allows easy reference to objects in FPP/autocoder required namespaces
 using namespace FlightComputer;
@@ -27,10 +34,32 @@ Os::Console logger;
 // initialization phase.
 Fw::MallocAllocator mallocator;
 
+// F´ framing that marks the end of startup once the first telemetry frame has been handed to the comm driver. Events
+// and file packets are framed through here too and often come first, so the packet type is checked. The framer
+// serializes calls into its protocol. Nothing is framed before the simulated cycle starts clocking the rate groups,
+// i.e. after setupTopology has recorded every other phase.
+class StartupFraming : public Svc::FprimeFraming {
+  public:
+    StartupFraming() : m_framed(false) {}
+
+    void frame(const U8* const data, const U32 size, Fw::ComPacket::ComPacketType packet_type) override {
+        Svc::FprimeFraming::frame(data, size, packet_type);
+        const bool telemetry = packet_type == Fw::ComPacket::FW_PACKET_TELEM ||
+                               packet_type == Fw::ComPacket::FW_PACKET_PACKETIZED_TLM;
+        if (telemetry && !m_framed) {
+            m_framed = true;
+            startupProfiler.end(StartupProfiler::FIRST_TELEMETRY);
+            startupProfiler.report();
+        }
+    }
+
+  private:
+    bool m_framed;
+};
+
 // The reference topology uses the F´ packet protocol when communicating with the ground and therefore uses the F´
 // framing and deframing implementations.
-Svc::FprimeFraming gdsFraming;
-Svc::FrameDetectors::FprimeFrameDetector frameDetector;
+StartupFraming gdsFraming;
 
 // The reference topology divides the incoming clock signal (1Hz) into sub-signals: 1Hz, 1/2Hz, and 1/4Hz and
 // zero offset for all the dividers
@@ -38,9 +67,40 @@ Svc::RateGroupDriver::DividerSet rateGroupDivisorsSet{{{1, 0}, {2, 0}, {4, 0}}};
 
 // Rate groups may supply a context token to each of the attached children whose purpose is set by the project. The
 // reference topology sets each token to zero as these contexts are unused in this project.
-NATIVE_INT_TYPE rateGroup1Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
-NATIVE_INT_TYPE rateGroup2Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
-NATIVE_INT_TYPE rateGroup3Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
+NATIVE_INT_TYPE rateGroup1Context[FlightComputer::DegradableRateGroup::CONNECTION_COUNT_MAX] = {};
+NATIVE_INT_TYPE rateGroup2Context[FlightComputer::DegradableRateGroup::CONNECTION_COUNT_MAX] = {};
+NATIVE_INT_TYPE rateGroup3Context[FlightComputer::DegradableRateGroup::CONNECTION_COUNT_MAX] = {};
+NATIVE_INT_TYPE rateGroup4Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
+
+// Rate groups 1-3 tag each member (in RateGroupMemberOut port order, see topology.fpp) as critical or deferrable. When a
+// group falls behind, deferrable members are deferred and then shed until it catches up; critical members always run.
+static const FlightComputer::DegradableRateGroup_MemberClass::T RG_CRITICAL =
+    FlightComputer::DegradableRateGroup_MemberClass::CRITICAL;
+static const FlightComputer::DegradableRateGroup_MemberClass::T RG_DEFERRABLE =
+    FlightComputer::DegradableRateGroup_MemberClass::DEFERRABLE;
+FlightComputer::DegradableRateGroup_MemberClass::T rateGroup1Classes[] = {
+    RG_CRITICAL,    // gdsChanTlm.Run
+    RG_CRITICAL,    // blockDrv.Sched
+    RG_DEFERRABLE,  // commsBufferManager.schedIn
+    RG_CRITICAL,    // flightSequencer.run
+    RG_DEFERRABLE,  // frameAccumulator.schedIn
+};
+FlightComputer::DegradableRateGroup_MemberClass::T rateGroup2Classes[] = {
+    RG_CRITICAL,  // cmdSeq.schedIn
+    RG_CRITICAL,  // flightSequencer.run
+    RG_CRITICAL,  // health.Run
+};
+FlightComputer::DegradableRateGroup_MemberClass::T rateGroup3Classes[] = {
+    RG_DEFERRABLE,  // systemResources.run
+    RG_DEFERRABLE,  // fileDownlink.Run
+};
+// The tables must track the connections; configure() also checks them against the connected ports at startup
+static_assert(FW_NUM_ARRAY_ELEMENTS(rateGroup1Classes) == FlightComputer::rateGroup1Members,
+              "rateGroup1Classes must classify every rate group 1 member");
+static_assert(FW_NUM_ARRAY_ELEMENTS(rateGroup2Classes) == FlightComputer::rateGroup2Members,
+              "rateGroup2Classes must classify every rate group 2 member");
+static_assert(FW_NUM_ARRAY_ELEMENTS(rateGroup3Classes) == FlightComputer::rateGroup3Members,
+              "rateGroup3Classes must classify every rate group 3 member");
 
 // A number of constants are needed for construction of the topology. These are specified here.
 enum TopologyConstants {
@@ -51,14 +111,55 @@ enum TopologyConstants {
     FILE_DOWNLINK_FILE_QUEUE_DEPTH = 10,
     HEALTH_WATCHDOG_CODE = 0x123,
     COMM_PRIORITY = 100,
-    // Buffer manager for Uplink/Downlink
+    // Buffer pool for Uplink/Downlink
     COMMS_BUFFER_MANAGER_STORE_SIZE = 2048,
     COMMS_BUFFER_MANAGER_STORE_COUNT = 20,
     COMMS_BUFFER_MANAGER_FILE_STORE_SIZE = 3000,
     COMMS_BUFFER_MANAGER_FILE_QUEUE_SIZE = 30,
     COMMS_BUFFER_MANAGER_ID = 200,
+    // Threads that get or return comms buffers, each given a cache: gdsChanTlm, eventLogger, fileDownlink and
+    // bulkDownlink frame and send downlink, the comm receive thread accumulates uplink, and fileUplink returns frames.
+    // A thread added beyond these works straight off the free lists.
+    COMMS_BUFFER_MANAGER_THREAD_CACHES = 6,
+    // Free buffers that may sit in those caches, per class
+    COMMS_BUFFER_MANAGER_CACHED = COMMS_BUFFER_MANAGER_THREAD_CACHES * FlightComputer::BufferPool::CACHE_DEPTH,
+    // Pool storage with every buffer rounded up to a cache line, plus headroom for the free list links
+    COMMS_BUFFER_ARENA_SIZE =
+        (COMMS_BUFFER_MANAGER_STORE_SIZE + 64) * (COMMS_BUFFER_MANAGER_STORE_COUNT + COMMS_BUFFER_MANAGER_CACHED) +
+        (COMMS_BUFFER_MANAGER_FILE_STORE_SIZE + 64) * (COMMS_BUFFER_MANAGER_FILE_QUEUE_SIZE + COMMS_BUFFER_MANAGER_CACHED) +
+        16 * 1024,
+    // Rate group 4 is clocked this many times per base (1Hz) cycle and drives the state estimator
+    ESTIMATOR_RATE_HZ = 200,
+    // Bytes the framer adds around a file packet payload: data packet header, packet descriptor, F´ frame header and
+    // frame checksum
+    BULK_DOWNLINK_PACKET_OVERHEAD = Fw::FilePacket::DataPacket::HEADERSIZE + sizeof(FwPacketDescriptorType) +
+                                    Svc::FpFrameHeader::SIZE + HASH_DIGEST_LENGTH,
+    // Bulk downlink payload per file packet, the largest whose framed packet fits a file store buffer, and downlink
+    // budget
+    BULK_DOWNLINK_CHUNK_SIZE = COMMS_BUFFER_MANAGER_FILE_STORE_SIZE - BULK_DOWNLINK_PACKET_OVERHEAD,
+    BULK_DOWNLINK_BYTES_PER_SECOND = 256 * 1024,
+    // Events per ID sent back to back (more for warning high IDs) and sustained per second, and events released to the
+    // logger per fast tick. The release budget stays well under the logger queue depth, bounding queued events at 400
+    // per second. Fatal and command events are forwarded at once on top of that.
+    EVENT_THROTTLE_BURST = 5,
+    EVENT_THROTTLE_WARNING_HI_BURST = 15,
+    EVENT_THROTTLE_RATE_PER_SECOND = 2,
+    EVENT_THROTTLE_DRAIN_PER_TICK = 2,
+    // Uplink frame ring: room for several of the largest frames held as views while more bytes arrive
+    FRAME_RING_SIZE = 16 * 1024,
 };
 
+// Full framed bulk packets must come from the file class, not the store class that telemetry and events draw on
+static_assert(BULK_DOWNLINK_CHUNK_SIZE + BULK_DOWNLINK_PACKET_OVERHEAD > COMMS_BUFFER_MANAGER_STORE_SIZE,
+              "Framed bulk downlink packets must not fit the store class");
+static_assert(BULK_DOWNLINK_CHUNK_SIZE <= FlightComputer::BulkDownlink::MAX_CHUNK_SIZE,
+              "Bulk downlink payload must fit its read buffer");
+
+// The comms buffer pool is backed by static storage so its pages can be faulted in on a helper thread while the rest
+// of the topology initializes, instead of on the first uplink/downlink buffer allocations.
+alignas(64) static U8 commsBufferArena[COMMS_BUFFER_ARENA_SIZE];
+FlightComputer::ArenaAllocator commsBufferAllocator(commsBufferArena, sizeof(commsBufferArena));
+
 // Ping entries are autocoded, however; this code is not properly exported. Thus, it is copied here.
 Svc::Health::PingEntry pingEntries[] = {
     {PingEntries::FlightComputer_blockDrv::WARN, PingEntries::FlightComputer_blockDrv::FATAL, "blockDrv"},
@@ -66,6 +167,7 @@ Svc::Health::PingEntry pingEntries[] = {
     {PingEntries::FlightComputer_cmdDisp::WARN, PingEntries::FlightComputer_cmdDisp::FATAL, "cmdDisp"},
     {PingEntries::FlightComputer_cmdSeq::WARN, PingEntries::FlightComputer_cmdSeq::FATAL, "cmdSeq"},
     {PingEntries::FlightComputer_eventLogger::WARN, PingEntries::FlightComputer_eventLogger::FATAL, "eventLogger"},
+    {PingEntries::FlightComputer_fastBlockDrv::WARN, PingEntries::FlightComputer_fastBlockDrv::FATAL, "fastBlockDrv"},
     {PingEntries::FlightComputer_fileDownlink::WARN, PingEntries::FlightComputer_fileDownlink::FATAL, "fileDownlink"},
     {PingEntries::FlightComputer_fileManager::WARN, PingEntries::FlightComputer_fileManager::FATAL, "fileManager"},
     {PingEntries::FlightComputer_fileUplink::WARN, PingEntries::FlightComputer_fileUplink::FATAL, "fileUplink"},
@@ -74,6 +176,7 @@ Svc::Health::PingEntry pingEntries[] = {
     {PingEntries::FlightComputer_rateGroup1Comp::WARN, PingEntries::FlightComputer_rateGroup1Comp::FATAL, "rateGroup1Comp"},
     {PingEntries::FlightComputer_rateGroup2Comp::WARN, PingEntries::FlightComputer_rateGroup2Comp::FATAL, "rateGroup2Comp"},
     {PingEntries::FlightComputer_rateGroup3Comp::WARN, PingEntries::FlightComputer_rateGroup3Comp::FATAL, "rateGroup3Comp"},
+    {PingEntries::FlightComputer_rateGroup4Comp::WARN, PingEntries::FlightComputer_rateGroup4Comp::FATAL, "rateGroup4Comp"},
 };
 
 /**
@@ -84,6 +187,10 @@ Svc::Health::PingEntry pingEntries[] = {
  * desired, but is extracted here for clarity.
  */
 void configureTopology() {
+    // Event rates come first so that events raised while configuring are already throttled at the configured rates
+    eventThrottle.configure(ESTIMATOR_RATE_HZ, EVENT_THROTTLE_BURST, EVENT_THROTTLE_WARNING_HI_BURST,
+                            EVENT_THROTTLE_RATE_PER_SECOND, EVENT_THROTTLE_DRAIN_PER_TICK);
+
     // Command sequencer needs to allocate memory to hold contents of command sequences
     cmdSeq.allocateBuffer(0, mallocator, CMD_SEQ_BUFFER_SIZE);
 
@@ -91,63 +198,149 @@ void configureTopology() {
     rateGroupDriverComp.configure(rateGroupDivisorsSet);
 
     // Rate groups require context arrays. Empty for FlightComputererence example.
-    rateGroup1Comp.configure(rateGroup1Context, FW_NUM_ARRAY_ELEMENTS(rateGroup1Context));
-    rateGroup2Comp.configure(rateGroup2Context, FW_NUM_ARRAY_ELEMENTS(rateGroup2Context));
-    rateGroup3Comp.configure(rateGroup3Context, FW_NUM_ARRAY_ELEMENTS(rateGroup3Context));
+    rateGroup1Comp.configure(rateGroup1Context, FW_NUM_ARRAY_ELEMENTS(rateGroup1Context), rateGroup1Classes,
+                             FW_NUM_ARRAY_ELEMENTS(rateGroup1Classes));
+    rateGroup2Comp.configure(rateGroup2Context, FW_NUM_ARRAY_ELEMENTS(rateGroup2Context), rateGroup2Classes,
+                             FW_NUM_ARRAY_ELEMENTS(rateGroup2Classes));
+    rateGroup3Comp.configure(rateGroup3Context, FW_NUM_ARRAY_ELEMENTS(rateGroup3Context), rateGroup3Classes,
+                             FW_NUM_ARRAY_ELEMENTS(rateGroup3Classes));
+    rateGroup4Comp.configure(rateGroup4Context, FW_NUM_ARRAY_ELEMENTS(rateGroup4Context));
+
+    // The estimator integrates at the rate of the group driving it
+    stateEstimator.configure(1.0f / static_cast<F32>(ESTIMATOR_RATE_HZ));
 
     // File downlink requires some project-derived properties.
     fileDownlink.configure(FILE_DOWNLINK_TIMEOUT, FILE_DOWNLINK_COOLDOWN, FILE_DOWNLINK_CYCLE_TIME,
                            FILE_DOWNLINK_FILE_QUEUE_DEPTH);
+    bulkDownlink.configure(BULK_DOWNLINK_CHUNK_SIZE, BULK_DOWNLINK_BYTES_PER_SECOND);
 
-    // Parameter database is configured with a database file name, and that file must be initially read.
-    // prmDb.configure("PrmDb.dat");
-    // prmDb.readParamFile();
+    // Parameter database is configured with a database file name. The file is read with the parameter load below.
+    prmDb.configure("PrmDb.dat");
 
     // Health is supplied a set of ping entires.
     health.setPingEntries(pingEntries, FW_NUM_ARRAY_ELEMENTS(pingEntries), HEALTH_WATCHDOG_CODE);
 
-    // Buffer managers need a configured set of buckets and an allocator used to allocate memory for those buckets.
-    Svc::BufferManager::BufferBins commsBuffMgrBins;
-    memset(&commsBuffMgrBins, 0, sizeof(commsBuffMgrBins));
-    commsBuffMgrBins.bins[0].bufferSize = COMMS_BUFFER_MANAGER_STORE_SIZE;
-    commsBuffMgrBins.bins[0].numBuffers = COMMS_BUFFER_MANAGER_STORE_COUNT;
-    commsBuffMgrBins.bins[1].bufferSize = COMMS_BUFFER_MANAGER_FILE_STORE_SIZE;
-    commsBuffMgrBins.bins[1].numBuffers = COMMS_BUFFER_MANAGER_FILE_QUEUE_SIZE;
-    commsBufferManager.setup(COMMS_BUFFER_MANAGER_ID, 0, mallocator, commsBuffMgrBins);
+    // The buffer pool needs its size classes, smallest first, and an allocator used to allocate memory for them.
+    const FlightComputer::BufferPool::SizeClass commsBufferClasses[] = {
+        {COMMS_BUFFER_MANAGER_STORE_SIZE, COMMS_BUFFER_MANAGER_STORE_COUNT + COMMS_BUFFER_MANAGER_CACHED},
+        {COMMS_BUFFER_MANAGER_FILE_STORE_SIZE, COMMS_BUFFER_MANAGER_FILE_QUEUE_SIZE + COMMS_BUFFER_MANAGER_CACHED},
+    };
+    commsBufferManager.setup(COMMS_BUFFER_MANAGER_ID, 0, commsBufferAllocator, commsBufferClasses,
+                             FW_NUM_ARRAY_ELEMENTS(commsBufferClasses), COMMS_BUFFER_MANAGER_THREAD_CACHES);
 
     // Framer and Deframer components need to be passed a protocol handler
     framer.setup(gdsFraming);
-    frameAccumulator.configure(frameDetector, 1, mallocator, 2048);
+    frameAccumulator.configure(1, mallocator, FRAME_RING_SIZE, COMMS_BUFFER_MANAGER_FILE_STORE_SIZE);
+}
+
+// Faults in the comms buffer pages, run on its own task during startup
+void prefaultCommsBuffers(void*) {
+    startupProfiler.begin(StartupProfiler::PREFAULT);
+    commsBufferAllocator.prefault();
+    startupProfiler.end(StartupProfiler::PREFAULT);
 }
 
 // Public functions for use in main program are namespaced with deployment name FlightComputer
 namespace FlightComputer {
 void setupTopology(const TopologyState& state) {
+    // Buffer pages are faulted in concurrently with component init and connection; only configuration needs them
+    Os::Task prefaultTask;
+    Os::TaskString prefaultName("PrefaultTask");
+    const Os::Task::Status prefaultStatus =
+        prefaultTask.start(Os::Task::Arguments(prefaultName, prefaultCommsBuffers, nullptr));
+    FW_ASSERT(prefaultStatus == Os::Task::OP_OK, prefaultStatus);
+
+    // The autocoded setup() is expanded here so that each phase can be timed
+    startupProfiler.begin(StartupProfiler::INIT);
+    initComponents(state);
+    startupProfiler.end(StartupProfiler::INIT);
+
+    startupProfiler.begin(StartupProfiler::CONNECT);
+    setBaseIds();
+    connectComponents();
+    regCommands();
+    startupProfiler.end(StartupProfiler::CONNECT);
+
+    (void)prefaultTask.join();
+
+    startupProfiler.begin(StartupProfiler::CONFIGURE);
     configureTopology();
-    setup(state);
-    // Initialize socket client communication if and only if there is a valid specification
+    startupProfiler.end(StartupProfiler::CONFIGURE);
+
+    // Initialize socket client communication if and only if there is a valid specification. The socket task is
+    // started before parameters and active tasks so that the connection handshake overlaps with them. Anything it
+    // receives early is held in the (already initialized) command dispatcher queue.
+    startupProfiler.begin(StartupProfiler::START_COMM);
     if (state.hostName != nullptr && state.uplinkPort != 0) {
         Os::TaskString name("ReceiveTask");
         // Uplink is configured for receive so a socket task is started
         comm.configure(state.hostName, state.uplinkPort);
         comm.start(name, true, COMM_PRIORITY, Default::stackSize);
     }
+    startupProfiler.end(StartupProfiler::START_COMM);
+
+    // A missing parameter file is reported and leaves every parameter at its default
+    startupProfiler.begin(StartupProfiler::LOAD_PARAMETERS);
+    prmDb.readParamFile();
+    loadParameters();
+    startupProfiler.end(StartupProfiler::LOAD_PARAMETERS);
 
+    startupProfiler.begin(StartupProfiler::START_TASKS);
+    startTasks(state);
+    startupProfiler.end(StartupProfiler::START_TASKS);
 }
 
 // Variables used for cycle simulation
 Os::Mutex cycleLock;
 volatile bool cycleFlag = true;
 
+namespace {
+const U64 NS_PER_SECOND = 1000000000ULL;
+
+U64 monotonicNs() {
+    timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<U64>(now.tv_sec) * NS_PER_SECOND + static_cast<U64>(now.tv_nsec);
+}
+
+void sleepUntilNs(const U64 deadlineNs) {
+    timespec deadline;
+    deadline.tv_sec = static_cast<time_t>(deadlineNs / NS_PER_SECOND);
+    deadline.tv_nsec = static_cast<long>(deadlineNs % NS_PER_SECOND);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+    }
+}
+}  // namespace
+
 void startSimulatedCycle(Fw::TimeInterval interval) {
     cycleLock.lock();
     bool cycling = cycleFlag;
     cycleLock.unLock();
 
+    // Split the base interval into fast ticks for rate group 4
+    const U64 intervalUs = static_cast<U64>(interval.getSeconds()) * 1000000 + interval.getUSeconds();
+    const U64 fastUs = intervalUs / ESTIMATOR_RATE_HZ;
+    FW_ASSERT(fastUs > 0);
+    const U64 intervalNs = intervalUs * 1000;
+
+    // Ticks are released at absolute deadlines on the monotonic clock, each at its exact offset into the base cycle, so
+    // neither the time spent dispatching nor the rounding of the fast period accumulates into drift
+    U64 cycleStartNs = monotonicNs();
+
     // Main loop
     while (cycling) {
         FlightComputer::blockDrv.callIsr();
-        Os::Task::delay(interval);
+        for (U32 tick = 0; tick < ESTIMATOR_RATE_HZ; tick++) {
+            FlightComputer::fastBlockDrv.callIsr();
+            sleepUntilNs(cycleStartNs + intervalNs * (tick + 1) / ESTIMATOR_RATE_HZ);
+        }
+        cycleStartNs += intervalNs;
+        // After a stall of a whole cycle or more (e.g. a debugger break) the schedule restarts from now instead of
+        // releasing the missed ticks back to back
+        const U64 nowNs = monotonicNs();
+        if (nowNs > cycleStartNs + intervalNs) {
+            cycleStartNs = nowNs;
+        }
 
         cycleLock.lock();
         cycling = cycleFlag;
@@ -172,6 +365,7 @@ void teardownTopology(const TopologyState& state) {
 
     // Resource deallocation
     cmdSeq.deallocateBuffer(mallocator);
+    frameAccumulator.cleanup();
     commsBufferManager.cleanup();
 }
 };  // namespace FlightComputer
@@ -26,6 +26,10 @@ namespace FlightComputer {
  * inserted between step 3 and 5. Step 7 may come before or after the active component initializations. Since these
  * custom tasks often start radio communication it is convenient to start them last.
  *
+ * In this deployment step 7 (the socket task) runs right after step 4 so the connection handshake overlaps steps 5 and
+ * 6, and buffer memory is pre-faulted on a helper task during steps 1-3. Each step is timed by startupProfiler and
+ * the report is logged once the first frame has been handed to the comm driver.
+ *
  * The state argument carries command line inputs used to setup the topology. For an explanation of the required type
  * Ref::TopologyState see: RefTopologyDefs.hpp.
  *
@@ -62,6 +66,9 @@ void teardownTopology(const TopologyState& state);
  * achieved. This function mimics the cycling via a Task::delay(Fw::Time()) loop that manually invokes the ISR call
  * to the example block driver.
  *
+ * Each interval is further divided into equal ticks of the fast block driver, which clocks rate group 4 (and with it
+ * the state estimator) directly at a multiple of the base rate.
+ *
  * This loop is stopped via a startSimulatedCycle call.
  *
  * Note: projects should replace this with a component that produces an output port call at the appropriate frequency.
@@ -49,6 +49,7 @@ namespace FlightComputer {
     namespace FlightComputer_cmdDisp { enum { WARN = 3, FATAL = 5 }; }
     namespace FlightComputer_cmdSeq { enum { WARN = 3, FATAL = 5 }; }
     namespace FlightComputer_eventLogger { enum { WARN = 3, FATAL = 5 }; }
+    namespace FlightComputer_fastBlockDrv { enum { WARN = 3, FATAL = 5 }; }
     namespace FlightComputer_fileDownlink { enum { WARN = 3, FATAL = 5 }; }
     namespace FlightComputer_fileManager { enum { WARN = 3, FATAL = 5 }; }
     namespace FlightComputer_fileUplink { enum { WARN = 3, FATAL = 5 }; }
@@ -57,6 +58,7 @@ namespace FlightComputer {
     namespace FlightComputer_rateGroup1Comp { enum { WARN = 3, FATAL = 5 }; }
     namespace FlightComputer_rateGroup2Comp { enum { WARN = 3, FATAL = 5 }; }
     namespace FlightComputer_rateGroup3Comp { enum { WARN = 3, FATAL = 5 }; }
+    namespace FlightComputer_rateGroup4Comp { enum { WARN = 3, FATAL = 5 }; }
   }
 
 }
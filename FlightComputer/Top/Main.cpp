@@ -8,6 +8,7 @@
 #include <Fw/Time/Time.hpp>
 #include <FlightComputer/Top/FlightComputerTopologyAc.hpp>
 #include <FlightComputer/Top/FlightComputerTopology.hpp>
+#include <FlightComputer/Trace/Trace.hpp>
 
 #include <signal.h>
 #include <cstdio>
@@ -20,6 +21,7 @@ void print_usage(const char* app) {
                   "-d, --downlink PORT\tset downlink port\n"
                   "-u, --uplink PORT\tset uplink port\n"
                   "-a, --address HOST\tset hostname/IP address\n"
+                  "-t, --trace FILE\trecord a trace from startup and write it to FILE on exit\n"
                   "-h, --help\t\tshow this help message\n", app);
 }
 
@@ -55,6 +57,7 @@ int main(int argc, char* argv[]) {
     U32 downlink_port = 0; // Invalid port number forced
     I32 option;
     char* hostname;
+    const char* traceFile = nullptr;
     option = 0;
     hostname = nullptr;
 
@@ -79,11 +82,12 @@ int main(int argc, char* argv[]) {
         {"uplink", required_argument, 0, 'u'},
         {"address", required_argument, 0, 'a'},
         {"persist", no_argument, 0, 'p'},
+        {"trace", required_argument, 0, 't'},
         {0, 0, 0, 0}
     };
 
     int option_index = 0;
-    while ((option = getopt_long(argc, argv, "hd:u:a:p", long_options, &option_index)) != -1) {
+    while ((option = getopt_long(argc, argv, "hd:u:a:pt:", long_options, &option_index)) != -1) {
         switch(option) {
             case 'h':
                 print_usage(argv[0]);
@@ -100,6 +104,9 @@ int main(int argc, char* argv[]) {
             case 'a':
                 hostname = optarg;
                 break;
+            case 't':
+                traceFile = optarg;
+                break;
             case '?':
             default:
                 EXIT_RET = EXIT_CODE_STARTUP_FAILURE;
@@ -120,6 +127,10 @@ int main(int argc, char* argv[]) {
     signal(SIGTERM, dfltSigHandler);
     signal(SIGUSR1, initFailureSigHandler);
 
+    if (traceFile != nullptr) {
+        FlightComputer::Trace::enable();
+    }
+
     Fw::Logger::log("Main Starting init\n");
     FlightComputer::TopologyState state(hostname, uplink_port, downlink_port);
     (void) printf("Setting up sw runtime\n");
@@ -127,6 +138,15 @@ int main(int argc, char* argv[]) {
     FlightComputer::startSimulatedCycle(Fw::TimeInterval(1, 0));  // Program loop cycling rate groups at 1Hz
     FlightComputer::teardownTopology(state);
 
+    if (traceFile != nullptr) {
+        U32 traceEvents = 0;
+        if (FlightComputer::Trace::dump(traceFile, traceEvents)) {
+            (void) printf("Wrote %u trace events to %s\n", traceEvents, traceFile);
+        } else {
+            fprintf(stderr, "Failed to write trace to %s\n", traceFile);
+        }
+    }
+
     // Give time for threads to exit
     (void) printf("Waiting for threads...\n");
     Os::Task::delay(Fw::TimeInterval(1, 0));
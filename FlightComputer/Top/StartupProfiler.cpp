@@ -0,0 +1,52 @@
+#include <FlightComputer/Top/StartupProfiler.hpp>
+#include <Fw/Logger/Logger.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace FlightComputer {
+
+namespace {
+const char* const PHASE_NAMES[StartupProfiler::NUM_PHASES] = {
+    "prefault", "init", "connect", "configure", "load parameters", "start tasks", "start comm", "first telemetry",
+};
+}
+
+StartupProfiler startupProfiler;
+
+StartupProfiler::StartupProfiler() : m_epoch(Clock::now()) {
+    for (U32 i = 0; i < NUM_PHASES; i++) {
+        m_beginUs[i] = 0;
+        m_endUs[i] = 0;
+        m_recorded[i] = false;
+    }
+}
+
+U32 StartupProfiler::nowUs() const {
+    return static_cast<U32>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_epoch).count());
+}
+
+void StartupProfiler::begin(const Phase phase) {
+    FW_ASSERT(phase < NUM_PHASES, phase);
+    m_beginUs[phase] = nowUs();
+}
+
+void StartupProfiler::end(const Phase phase) {
+    FW_ASSERT(phase < NUM_PHASES, phase);
+    m_endUs[phase] = nowUs();
+    m_recorded[phase] = true;
+}
+
+void StartupProfiler::report() const {
+    Fw::Logger::log("Startup report (us since exec):\n");
+    for (U32 i = 0; i < NUM_PHASES; i++) {
+        if (!m_recorded[i]) {
+            continue;
+        }
+        Fw::Logger::log("  %-16s start %8u end %8u took %8u\n", PHASE_NAMES[i], m_beginUs[i], m_endUs[i],
+                        m_endUs[i] - m_beginUs[i]);
+    }
+    if (m_recorded[FIRST_TELEMETRY]) {
+        Fw::Logger::log("  exec to first telemetry: %u us\n", m_endUs[FIRST_TELEMETRY]);
+    }
+}
+
+}  // namespace FlightComputer
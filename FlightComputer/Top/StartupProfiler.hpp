@@ -0,0 +1,56 @@
+#ifndef STARTUPPROFILER_H_
+#define STARTUPPROFILER_H_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <chrono>
+
+namespace FlightComputer {
+
+/**
+ * \brief records how long each topology bring-up phase takes
+ *
+ * The epoch is taken when the profiler is constructed, which for the global instance is static initialization, i.e.
+ * as close to exec as user code gets. Each phase records its own begin/end so phases running concurrently on other
+ * threads (e.g. buffer pre-faulting) are reported with their real overlap. A phase must only be marked from a single
+ * thread, and report() must only be called once every thread marking phases has been joined.
+ */
+class StartupProfiler {
+  public:
+    enum Phase {
+        PREFAULT,         //!< Touching buffer memory so the first allocations do not page fault (concurrent)
+        INIT,             //!< Autocoded component init
+        CONNECT,          //!< Base ids, port connections and command registration
+        CONFIGURE,        //!< Project specific configuration (configureTopology)
+        LOAD_PARAMETERS,  //!< Parameter database read and component parameter load
+        START_TASKS,      //!< Active component task start
+        START_COMM,       //!< Socket task start (connects concurrently with the remaining phases)
+        FIRST_TELEMETRY,  //!< Exec to the first telemetry frame handed to the comm driver for downlink
+        NUM_PHASES
+    };
+
+    StartupProfiler();
+
+    void begin(const Phase phase);
+    void end(const Phase phase);
+
+    //! Log one line per recorded phase plus the total time from exec to first telemetry
+    void report() const;
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    //! Microseconds since the profiler epoch
+    U32 nowUs() const;
+
+    Clock::time_point m_epoch;
+    U32 m_beginUs[NUM_PHASES];
+    U32 m_endUs[NUM_PHASES];
+    bool m_recorded[NUM_PHASES];
+};
+
+//! Profiler for the deployment, constructed at static initialization
+extern StartupProfiler startupProfiler;
+
+}  // namespace FlightComputer
+
+#endif  // STARTUPPROFILER_H_
@@ -0,0 +1,187 @@
+#include <FlightComputer/Trace/Trace.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace FlightComputer {
+namespace Trace {
+
+namespace {
+
+struct Event {
+    U64 tsNs;
+    const char* category;
+    const char* name;
+    U64 id;
+    I32 arg0;
+    I32 arg1;
+    char phase;
+};
+
+// Cache line aligned so neighbouring threads' write cursors never share a line
+struct alignas(64) ThreadRing {
+    std::atomic<bool> ready;   //!< Set once the claiming thread has filled in the fields below
+    std::atomic<U32> written;  //!< Total events ever written; the ring holds the last EVENTS_PER_THREAD
+    U32 tid;
+    char threadName[16];
+    Event events[EVENTS_PER_THREAD];
+};
+
+ThreadRing s_rings[MAX_THREADS];
+std::atomic<U32> s_ringsClaimed(0);
+std::atomic<U32> s_dropped(0);
+const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+thread_local ThreadRing* t_ring = nullptr;
+thread_local bool t_ringExhausted = false;
+
+ThreadRing* claimRing() {
+    const U32 slot = s_ringsClaimed.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= MAX_THREADS) {
+        t_ringExhausted = true;
+        return nullptr;
+    }
+    ThreadRing* ring = &s_rings[slot];
+    ring->tid = static_cast<U32>(syscall(SYS_gettid));
+    if (pthread_getname_np(pthread_self(), ring->threadName, sizeof(ring->threadName)) != 0) {
+        (void)snprintf(ring->threadName, sizeof(ring->threadName), "tid-%u", ring->tid);
+    }
+    ring->written.store(0, std::memory_order_relaxed);
+    // Publishes the ring to dump(), which may already count the slot as claimed
+    ring->ready.store(true, std::memory_order_release);
+    return ring;
+}
+
+// JSON strings we emit are literals from our own code; only quotes and backslashes need escaping
+void writeString(FILE* file, const char* str) {
+    (void)fputc('"', file);
+    for (const char* c = str; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            (void)fputc('\\', file);
+        }
+        (void)fputc(*c, file);
+    }
+    (void)fputc('"', file);
+}
+
+}  // namespace
+
+std::atomic<bool> s_enabled(false);
+
+void enable() {
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+void disable() {
+    s_enabled.store(false, std::memory_order_relaxed);
+}
+
+U32 droppedEvents() {
+    return s_dropped.load(std::memory_order_relaxed);
+}
+
+void record(const Phase phase, const char* category, const char* name, const U64 id, const I32 arg0,
+            const I32 arg1) {
+    ThreadRing* ring = t_ring;
+    if (ring == nullptr) {
+        if (t_ringExhausted || (ring = claimRing()) == nullptr) {
+            s_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        t_ring = ring;
+    }
+
+    // Single writer per ring: a relaxed read of our own cursor is enough, the release store publishes the event
+    const U32 index = ring->written.load(std::memory_order_relaxed);
+    Event& event = ring->events[index % EVENTS_PER_THREAD];
+    event.tsNs = static_cast<U64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count());
+    event.category = category;
+    event.name = name;
+    event.id = id;
+    event.arg0 = arg0;
+    event.arg1 = arg1;
+    event.phase = static_cast<char>(phase);
+    ring->written.store(index + 1, std::memory_order_release);
+}
+
+bool dump(const char* fileName, U32& eventCount) {
+    FW_ASSERT(fileName != nullptr);
+    eventCount = 0;
+
+    FILE* file = fopen(fileName, "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    // Pause recording so writers are not lapping the rings while they are read. An event already in flight on
+    // another thread may still land in its ring; at worst that single entry is torn.
+    const bool wasEnabled = s_enabled.exchange(false);
+
+    const U32 pid = static_cast<U32>(getpid());
+    const U32 claimed = s_ringsClaimed.load(std::memory_order_relaxed);
+    const U32 rings = (claimed < MAX_THREADS) ? claimed : static_cast<U32>(MAX_THREADS);
+
+    (void)fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    for (U32 r = 0; r < rings; r++) {
+        const ThreadRing& ring = s_rings[r];
+        if (!ring.ready.load(std::memory_order_acquire)) {
+            // Claimed by a thread that has not finished setting it up, so it holds no events yet
+            continue;
+        }
+        const U32 written = ring.written.load(std::memory_order_acquire);
+
+        (void)fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":",
+                      first ? "" : ",\n", pid, ring.tid);
+        writeString(file, ring.threadName);
+        (void)fprintf(file, "}}");
+        first = false;
+
+        const U32 count = (written < EVENTS_PER_THREAD) ? written : static_cast<U32>(EVENTS_PER_THREAD);
+        for (U32 i = written - count; i != written; i++) {
+            const Event& event = ring.events[i % EVENTS_PER_THREAD];
+            (void)fprintf(file, ",\n{\"ph\":\"%c\",\"pid\":%u,\"tid\":%u,\"ts\":%llu.%03u,\"cat\":", event.phase, pid,
+                          ring.tid, static_cast<unsigned long long>(event.tsNs / 1000),
+                          static_cast<U32>(event.tsNs % 1000));
+            writeString(file, event.category);
+            (void)fprintf(file, ",\"name\":");
+            writeString(file, event.name);
+            switch (event.phase) {
+                case PHASE_FLOW_START:
+                    (void)fprintf(file, ",\"id\":%llu", static_cast<unsigned long long>(event.id));
+                    break;
+                case PHASE_FLOW_END:
+                    // Bind to the enclosing slice (the handler span) rather than the next one
+                    (void)fprintf(file, ",\"id\":%llu,\"bp\":\"e\"", static_cast<unsigned long long>(event.id));
+                    break;
+                case PHASE_INSTANT:
+                    (void)fprintf(file, ",\"s\":\"t\",\"args\":{\"arg0\":%d,\"arg1\":%d}", event.arg0, event.arg1);
+                    break;
+                default:
+                    break;
+            }
+            (void)fputc('}', file);
+            eventCount++;
+        }
+    }
+    (void)fprintf(file, "\n]}\n");
+
+    bool ok = (ferror(file) == 0);
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+
+    if (wasEnabled) {
+        enable();
+    }
+    return ok;
+}
+
+}  // namespace Trace
+}  // namespace FlightComputer
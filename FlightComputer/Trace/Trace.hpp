@@ -0,0 +1,172 @@
+#ifndef TRACE_TRACE_H_
+#define TRACE_TRACE_H_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <atomic>
+
+// Compile-time switch. With FC_TRACING set to 0 every macro below expands to nothing.
+#ifndef FC_TRACING
+#define FC_TRACING 1
+#endif
+
+namespace FlightComputer {
+namespace Trace {
+
+/**
+ * \brief in-process span/flow tracer exporting Chrome trace JSON
+ *
+ * Every thread that records gets its own fixed-size ring of events, claimed from a static pool on its first event, so
+ * recording is a clock read and a handful of stores with no locks and no heap. Rings overwrite their oldest entries
+ * once full so a dump always holds the most recent history of each thread.
+ *
+ * Recording is off until enable() is called; while off each macro costs one relaxed atomic load and a branch.
+ *
+ * The produced JSON loads in chrome://tracing and ui.perfetto.dev. Names and categories are stored by pointer and
+ * must therefore be string literals (or otherwise outlive the dump).
+ */
+
+enum {
+    MAX_THREADS = 32,          //!< Threads that can record; later threads count as dropped
+    EVENTS_PER_THREAD = 4096,  //!< Ring size per thread
+};
+
+//! Chrome trace event phases used by the tracer
+enum Phase {
+    PHASE_BEGIN = 'B',
+    PHASE_END = 'E',
+    PHASE_INSTANT = 'i',
+    PHASE_FLOW_START = 's',
+    PHASE_FLOW_END = 'f',
+};
+
+extern std::atomic<bool> s_enabled;
+
+inline bool isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void enable();
+void disable();
+
+//! Record one event on the calling thread's ring
+void record(const Phase phase, const char* category, const char* name, const U64 id = 0, const I32 arg0 = 0,
+            const I32 arg1 = 0);
+
+//! Events lost because more than MAX_THREADS threads recorded
+U32 droppedEvents();
+
+/**
+ * \brief write every thread's ring as Chrome trace JSON
+ *
+ * Recording is paused for the duration of the dump and restored afterwards.
+ *
+ * \param fileName: output path
+ * \param eventCount: receives the number of events written
+ * \return false if the file could not be written
+ */
+bool dump(const char* fileName, U32& eventCount);
+
+//! RAII begin/end span. The end is only recorded if the begin was.
+class Scope {
+  public:
+    Scope(const char* category, const char* name) : m_category(category), m_name(name), m_active(isEnabled()) {
+        if (m_active) {
+            record(PHASE_BEGIN, m_category, m_name);
+        }
+    }
+    ~Scope() {
+        if (m_active) {
+            record(PHASE_END, m_category, m_name);
+        }
+    }
+
+  private:
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+    const char* const m_category;
+    const char* const m_name;
+    const bool m_active;
+};
+
+/**
+ * \brief pairs the enqueue and dispatch sides of a FIFO queue into flow ids
+ *
+ * Both counters advance whether or not tracing is enabled so the nth enqueue always matches the nth dispatch.
+ */
+class QueueFlow {
+  public:
+    QueueFlow() : m_enqueued(0), m_dispatched(0) {}
+    U64 enqueue() { return m_enqueued.fetch_add(1, std::memory_order_relaxed); }
+    //! Take back the last enqueue, whose message never made it into the queue. Single producer queues only.
+    U64 drop() { return m_enqueued.fetch_sub(1, std::memory_order_relaxed) - 1; }
+    U64 dispatch() { return m_dispatched.fetch_add(1, std::memory_order_relaxed); }
+
+  private:
+    std::atomic<U64> m_enqueued;
+    std::atomic<U64> m_dispatched;
+};
+
+}  // namespace Trace
+}  // namespace FlightComputer
+
+#if FC_TRACING
+#define FC_TRACE_CONCAT_(a, b) a##b
+#define FC_TRACE_CONCAT(a, b) FC_TRACE_CONCAT_(a, b)
+
+//! Span covering the rest of the enclosing scope
+#define FC_TRACE_SCOPE(category, name) \
+    ::FlightComputer::Trace::Scope FC_TRACE_CONCAT(fcTraceScope_, __LINE__)(category, name)
+
+//! Point event with two integer arguments
+#define FC_TRACE_INSTANT(category, name, arg0, arg1) \
+    do { \
+        if (::FlightComputer::Trace::isEnabled()) { \
+            ::FlightComputer::Trace::record(::FlightComputer::Trace::PHASE_INSTANT, category, name, 0, arg0, arg1); \
+        } \
+    } while (0)
+
+//! Message enqueued on a QueueFlow, call from the async port's pre-message hook
+#define FC_TRACE_ENQUEUE(flow, category, name) \
+    do { \
+        const U64 fcTraceId = (flow).enqueue(); \
+        if (::FlightComputer::Trace::isEnabled()) { \
+            ::FlightComputer::Trace::record(::FlightComputer::Trace::PHASE_FLOW_START, category, name, fcTraceId); \
+        } \
+    } while (0)
+
+//! Message dropped by a full queue, call from the async port's overflow hook. Ends the message's flow where it was
+//! dropped; its id is reused by the next enqueue.
+#define FC_TRACE_DROP(flow, category, name) \
+    do { \
+        const U64 fcTraceId = (flow).drop(); \
+        if (::FlightComputer::Trace::isEnabled()) { \
+            ::FlightComputer::Trace::record(::FlightComputer::Trace::PHASE_FLOW_END, category, name, fcTraceId); \
+        } \
+    } while (0)
+
+//! Message dispatched from a QueueFlow, call inside the handler's span
+#define FC_TRACE_DISPATCH(flow, category, name) \
+    do { \
+        const U64 fcTraceId = (flow).dispatch(); \
+        if (::FlightComputer::Trace::isEnabled()) { \
+            ::FlightComputer::Trace::record(::FlightComputer::Trace::PHASE_FLOW_END, category, name, fcTraceId); \
+        } \
+    } while (0)
+#else
+#define FC_TRACE_SCOPE(category, name)
+#define FC_TRACE_INSTANT(category, name, arg0, arg1) \
+    do { \
+    } while (0)
+#define FC_TRACE_ENQUEUE(flow, category, name) \
+    do { \
+    } while (0)
+#define FC_TRACE_DROP(flow, category, name) \
+    do { \
+    } while (0)
+#define FC_TRACE_DISPATCH(flow, category, name) \
+    do { \
+    } while (0)
+#endif
+
+#endif  // TRACE_TRACE_H_
@@ -0,0 +1,58 @@
+// ======================================================================
+// \title  TraceBench.cpp
+// \brief  measures the cost of a trace point with recording off and on
+//
+// Usage: ./TraceBench [iterations] [dump file]
+// ======================================================================
+
+#include "FlightComputer/Trace/Trace.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace FlightComputer;
+
+namespace {
+    volatile U32 sink;
+
+    double nsPerIteration(const U32 iterations) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (U32 i = 0; i < iterations; i++) {
+            FC_TRACE_SCOPE("bench", "scope");
+            FC_TRACE_INSTANT("bench", "instant", static_cast<I32>(i), 0);
+            sink = i;
+        }
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+               static_cast<double>(iterations);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const U32 iterations = (argc > 1) ? static_cast<U32>(std::strtoul(argv[1], nullptr, 10)) : 1000000U;
+    if (iterations == 0) {
+        (void) fprintf(stderr, "Usage: %s [iterations] [dump file]\n", argv[0]);
+        return 1;
+    }
+
+    // Each iteration records three events (begin, instant, end) when enabled
+    const double offNs = nsPerIteration(iterations);
+    Trace::enable();
+    const double onNs = nsPerIteration(iterations);
+    Trace::disable();
+
+    (void) printf("Trace points over %u iterations (3 events each)\n", iterations);
+    (void) printf("  disabled: %8.2f ns/event\n", offNs / 3.0);
+    (void) printf("  enabled:  %8.2f ns/event\n", onNs / 3.0);
+
+    if (argc > 2) {
+        U32 events = 0;
+        if (!Trace::dump(argv[2], events)) {
+            (void) fprintf(stderr, "Failed to write %s\n", argv[2]);
+            return 1;
+        }
+        (void) printf("  wrote %u events to %s\n", events, argv[2]);
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+// ======================================================================
+// \title  TraceControl.cpp
+// \brief  cpp file for TraceControl component implementation class
+// ======================================================================
+
+#include <FlightComputer/TraceControl/TraceControl.hpp>
+#include <FlightComputer/Trace/Trace.hpp>
+
+namespace FlightComputer {
+
+  TraceControl ::
+    TraceControl(
+        const char *const compName
+    ) : TraceControlComponentBase(compName)
+  {
+
+  }
+
+  TraceControl ::~TraceControl() {}
+
+  void TraceControl ::
+    init(
+        const NATIVE_INT_TYPE queueDepth,
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    TraceControlComponentBase::init(queueDepth, instance);
+  }
+
+  // ----------------------------------------------------------------------
+  // Command handler implementations
+  // ----------------------------------------------------------------------
+
+  void TraceControl ::
+    TRACE_START_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    Trace::enable();
+    log_ACTIVITY_HI_TraceStarted();
+    cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void TraceControl ::
+    TRACE_STOP_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    Trace::disable();
+    log_ACTIVITY_HI_TraceStopped();
+    cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void TraceControl ::
+    TRACE_DUMP_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& fileName
+    )
+  {
+    U32 events = 0;
+    if (!Trace::dump(fileName.toChar(), events)) {
+      log_WARNING_HI_TraceDumpFailed(fileName);
+      cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    log_ACTIVITY_HI_TraceDumped(fileName, events, Trace::droppedEvents());
+    cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+} // end namespace FlightComputer
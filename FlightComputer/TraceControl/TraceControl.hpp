@@ -0,0 +1,44 @@
+#ifndef TraceControl_HPP
+#define TraceControl_HPP
+
+#include "FlightComputer/TraceControl/TraceControlComponentAc.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+
+namespace FlightComputer {
+  class TraceControl :
+  public TraceControlComponentBase
+  {
+
+    public:
+
+        // ----------------------------------------------------------------------
+        // Construction, initialization, and destruction
+        // ----------------------------------------------------------------------
+
+        //! Construct object TraceControl
+        //!
+        TraceControl(
+            const char *const compName /*!< The component name*/
+        );
+
+        //! Initialize object TraceControl
+        //!
+        void init(
+            const NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
+            const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+        );
+
+        //! Destroy object TraceControl
+        //!
+        ~TraceControl();
+
+    PRIVATE:
+
+        void TRACE_START_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq);
+        void TRACE_STOP_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq);
+        void TRACE_DUMP_cmdHandler(const FwOpcodeType opCode, const U32 cmdSeq, const Fw::CmdStringArg& fileName);
+
+    };
+
+} // end namespace FlightComputer
+#endif
@@ -0,0 +1,419 @@
+#!/usr/bin/env python3
+"""Uplink command-throughput load generator
+
+Stand-in ground station for the FlightComputer deployment. It listens where fprime-gds normally would, waits for the
+flight computer to connect (``FlightComputer -a <host> -u <port> -d <port>``) and then drives the uplink chain
+(comm -> frameAccumulator -> deframer -> uplinkRouter -> cmdDisp) with F' framed commands at one or more offered
+rates. Each command is timed from the moment it is written to the socket until cmdDisp reports it dispatched and
+completed, using the OpCodeDispatched/OpCodeCompleted events that come back on the downlink.
+
+Responses carry only the opcode, so they are matched to sends first-in first-out per opcode. cmdDisp handles
+commands in arrival order so this is exact as long as nothing is lost; anything still outstanding once a step has
+drained is counted as dropped.
+
+Only the standard library is used so it can run anywhere the flight computer can reach over TCP:
+
+    python3 uplink_load.py --port 50000 --dictionary FlightComputerTopologyDictionary.json \\
+        --rates 10,50,100,200,400 --duration 10 \\
+        --mix flightSequencer.IGNITE=1,flightSequencer.TERMINATE=1,cmdDisp.CMD_NO_OP=8
+
+COMMAND severity events must not be filtered by the event logger, otherwise no completions are seen.
+"""
+import argparse
+import collections
+import json
+import math
+import random
+import socket
+import struct
+import sys
+import threading
+import time
+import xml.etree.ElementTree as ElementTree
+import zlib
+
+# F' framing protocol (Svc/FramingProtocol/FprimeProtocol): start word, payload size, payload, CRC32 of all before it
+START_WORD = 0xDEADBEEF
+FRAME_HEADER = struct.Struct(">II")
+FRAME_CRC = struct.Struct(">I")
+START_BYTES = struct.pack(">I", START_WORD)
+
+# Fw::ComPacket descriptors, serialized as FwPacketDescriptorType (U32)
+PACKET_COMMAND = 0
+PACKET_LOG = 2
+
+# Event packet: descriptor, FwEventIdType id, Fw::Time (U16 base, U8 context, U32 seconds, U32 useconds), arguments
+EVENT_HEADER = struct.Struct(">IIHBII")
+OPCODE = struct.Struct(">I")
+
+# cmdDisp events the responses are read from
+REQUIRED_EVENTS = (
+    "cmdDisp.OpCodeDispatched",
+    "cmdDisp.OpCodeCompleted",
+    "cmdDisp.OpCodeError",
+    "cmdDisp.MalformedCommand",
+    "cmdDisp.InvalidCommand",
+    "cmdDisp.TooManyCommands",
+)
+DEFAULT_MIX = "flightSequencer.IGNITE=1,flightSequencer.TERMINATE=1,cmdDisp.CMD_NO_OP=8"
+
+
+def frame(payload):
+    """Wrap a packet in an F' frame"""
+    header = FRAME_HEADER.pack(START_WORD, len(payload))
+    crc = zlib.crc32(payload, zlib.crc32(header)) & 0xFFFFFFFF
+    return header + payload + FRAME_CRC.pack(crc)
+
+
+def command_packet(opcode):
+    """Serialize an argument-less command as cmdDisp expects it on seqCmdBuff"""
+    return struct.pack(">II", PACKET_COMMAND, opcode)
+
+
+class Deframer:
+    """Incremental F' deframer; resynchronizes on the start word after garbage or a bad CRC"""
+
+    def __init__(self):
+        self.data = bytearray()
+        self.bad_frames = 0
+
+    def feed(self, chunk):
+        self.data.extend(chunk)
+        packets = []
+        while True:
+            start = self.data.find(START_BYTES)
+            if start < 0:
+                # Keep a possible partial start word
+                del self.data[:max(0, len(self.data) - 3)]
+                return packets
+            del self.data[:start]
+            if len(self.data) < FRAME_HEADER.size:
+                return packets
+            _, size = FRAME_HEADER.unpack_from(self.data)
+            total = FRAME_HEADER.size + size + FRAME_CRC.size
+            if len(self.data) < total:
+                return packets
+            body = bytes(self.data[:FRAME_HEADER.size + size])
+            (crc,) = FRAME_CRC.unpack_from(self.data, FRAME_HEADER.size + size)
+            if zlib.crc32(body) & 0xFFFFFFFF != crc:
+                self.bad_frames += 1
+                del self.data[:1]
+                continue
+            packets.append(body[FRAME_HEADER.size:])
+            del self.data[:total]
+
+
+def load_dictionary(path):
+    """Read command opcodes and event ids from a JSON (fprime >= 3.5) or XML topology dictionary
+
+    Names are returned as "<instance>.<mnemonic>" with the deployment prefix stripped.
+    """
+    commands = {}
+    events = {}
+    if path.endswith(".json"):
+        with open(path) as f:
+            dictionary = json.load(f)
+        for command in dictionary.get("commands", []):
+            commands[".".join(command["name"].split(".")[-2:])] = int(command["opcode"])
+        for event in dictionary.get("events", []):
+            events[".".join(event["name"].split(".")[-2:])] = int(event["id"])
+    else:
+        root = ElementTree.parse(path).getroot()
+        for command in root.iter("command"):
+            name = "{}.{}".format(command.get("component"), command.get("mnemonic"))
+            commands[name] = int(command.get("opcode"), 0)
+        for event in root.iter("event"):
+            name = "{}.{}".format(event.get("component"), event.get("name"))
+            events[name] = int(event.get("id"), 0)
+    return commands, events
+
+
+def parse_mix(text, opcodes):
+    """Parse "name=weight,..." into (names, opcodes, weights)"""
+    names, codes, weights = [], [], []
+    for item in text.split(","):
+        name, _, weight = item.partition("=")
+        name = name.strip()
+        if name not in opcodes:
+            raise ValueError("unknown command '{}', known: {}".format(name, ", ".join(sorted(opcodes))))
+        names.append(name)
+        codes.append(opcodes[name])
+        weights.append(float(weight) if weight else 1.0)
+    return names, codes, weights
+
+
+def percentile(ordered, fraction):
+    """Nearest-rank percentile of an already sorted list"""
+    if not ordered:
+        return float("nan")
+    rank = max(0, min(len(ordered) - 1, math.ceil(fraction * len(ordered)) - 1))
+    return ordered[rank]
+
+
+class Step:
+    """Counters for one offered rate"""
+
+    def __init__(self, rate):
+        self.rate = rate
+        self.sent = 0
+        self.send_elapsed = 0.0
+        self.completed = 0
+        self.errors = 0
+        self.invalid = 0
+        self.malformed = 0
+        self.queue_full = 0
+        self.dropped = 0
+        self.unmatched = 0
+        self.first_send = None
+        self.last_completion = None
+        self.dispatch_latencies = []
+        self.completion_latencies = []
+
+    def summary(self):
+        dispatch = sorted(self.dispatch_latencies)
+        completion = sorted(self.completion_latencies)
+        window = (self.last_completion - self.first_send) if self.last_completion and self.first_send else 0.0
+        return {
+            "offered_rate": self.rate,
+            "achieved_send_rate": self.sent / self.send_elapsed if self.send_elapsed > 0 else 0.0,
+            "sent": self.sent,
+            "completed": self.completed,
+            "throughput": self.completed / window if window > 0 else 0.0,
+            "errors": self.errors,
+            "invalid": self.invalid,
+            "malformed": self.malformed,
+            "queue_full": self.queue_full,
+            "dropped": self.dropped,
+            "unmatched": self.unmatched,
+            "dispatch_ms": {p: percentile(dispatch, f) * 1e3 for p, f in (("p50", 0.5), ("p99", 0.99), ("p999", 0.999))},
+            "completion_ms": {p: percentile(completion, f) * 1e3 for p, f in (("p50", 0.5), ("p99", 0.99), ("p999", 0.999))},
+        }
+
+
+class Ground:
+    """Owns the flight computer connection and matches downlinked events to outstanding commands"""
+
+    def __init__(self, connection, events):
+        self.connection = connection
+        self.lock = threading.Lock()
+        self.deframer = Deframer()
+        self.link_up = True
+        self.step = None
+        # Per opcode: commands not yet dispatched, and dispatched commands not yet completed
+        self.awaiting_dispatch = collections.defaultdict(collections.deque)
+        self.awaiting_completion = collections.defaultdict(collections.deque)
+
+        self.event_dispatched = events["cmdDisp.OpCodeDispatched"]
+        self.event_completed = events["cmdDisp.OpCodeCompleted"]
+        self.event_error = events["cmdDisp.OpCodeError"]
+        self.event_malformed = events["cmdDisp.MalformedCommand"]
+        self.event_invalid = events["cmdDisp.InvalidCommand"]
+        self.event_too_many = events["cmdDisp.TooManyCommands"]
+
+        self.receiver = threading.Thread(target=self.receive, name="downlink", daemon=True)
+        self.receiver.start()
+
+    def send(self, opcode, packet):
+        now = time.perf_counter()
+        with self.lock:
+            self.awaiting_dispatch[opcode].append([now, None])
+            self.step.sent += 1
+            if self.step.first_send is None:
+                self.step.first_send = now
+        self.connection.sendall(packet)
+
+    def pop(self, opcode, dispatched):
+        """Oldest outstanding command for opcode, preferring the queue the event implies"""
+        queues = (self.awaiting_completion, self.awaiting_dispatch) if dispatched else \
+            (self.awaiting_dispatch, self.awaiting_completion)
+        for queue in queues:
+            if queue[opcode]:
+                return queue[opcode].popleft()
+        return None
+
+    def on_event(self, event_id, args, now):
+        step = self.step
+        if step is None:
+            return
+        if event_id == self.event_malformed:
+            step.malformed += 1
+            return
+        if event_id not in (self.event_dispatched, self.event_completed, self.event_error, self.event_invalid,
+                            self.event_too_many) or len(args) < OPCODE.size:
+            return
+        (opcode,) = OPCODE.unpack_from(args)
+
+        if event_id == self.event_dispatched:
+            if self.awaiting_dispatch[opcode]:
+                command = self.awaiting_dispatch[opcode].popleft()
+                command[1] = now
+                step.dispatch_latencies.append(now - command[0])
+                self.awaiting_completion[opcode].append(command)
+            return
+
+        command = self.pop(opcode, event_id in (self.event_completed, self.event_error))
+        if command is None:
+            step.unmatched += 1
+            return
+        if event_id == self.event_completed:
+            step.completed += 1
+            step.completion_latencies.append(now - command[0])
+            step.last_completion = now
+        elif event_id == self.event_error:
+            step.errors += 1
+        elif event_id == self.event_invalid:
+            step.invalid += 1
+        else:
+            # cmdDisp's tracking table was full: the command was refused before dispatch
+            step.queue_full += 1
+
+    def receive(self):
+        while True:
+            try:
+                chunk = self.connection.recv(65536)
+            except OSError:
+                chunk = b""
+            if not chunk:
+                with self.lock:
+                    self.link_up = False
+                return
+            now = time.perf_counter()
+            packets = self.deframer.feed(chunk)
+            with self.lock:
+                for packet in packets:
+                    if len(packet) < EVENT_HEADER.size:
+                        continue
+                    descriptor, event_id = struct.unpack_from(">II", packet)
+                    if descriptor == PACKET_LOG:
+                        self.on_event(event_id, packet[EVENT_HEADER.size:], now)
+
+    def outstanding(self):
+        return sum(len(q) for q in self.awaiting_dispatch.values()) + \
+            sum(len(q) for q in self.awaiting_completion.values())
+
+    def finish_step(self, drain):
+        """Wait for stragglers, then count whatever is still outstanding as dropped"""
+        deadline = time.perf_counter() + drain
+        while time.perf_counter() < deadline:
+            with self.lock:
+                if self.outstanding() == 0 or not self.link_up:
+                    break
+            time.sleep(0.01)
+        with self.lock:
+            step = self.step
+            step.dropped = self.outstanding()
+            self.awaiting_dispatch.clear()
+            self.awaiting_completion.clear()
+            self.step = None
+        return step
+
+
+def run_step(ground, rate, duration, drain, arrivals, codes, weights, rng):
+    packets = {code: frame(command_packet(code)) for code in codes}
+    with ground.lock:
+        ground.step = Step(rate)
+    start = time.perf_counter()
+    next_send = start
+    end = start + duration
+    while next_send < end:
+        delay = next_send - time.perf_counter()
+        if delay > 0:
+            time.sleep(delay)
+        opcode = rng.choices(codes, weights)[0]
+        try:
+            ground.send(opcode, packets[opcode])
+        except OSError:
+            break
+        # Open loop: the schedule does not wait on responses, so a slow uplink shows up as latency and loss
+        next_send += rng.expovariate(rate) if arrivals == "poisson" else 1.0 / rate
+    sent_elapsed = time.perf_counter() - start
+    step = ground.finish_step(drain)
+    step.send_elapsed = sent_elapsed
+    return step.summary()
+
+
+def print_table(results):
+    header = "{:>8} {:>8} {:>7} {:>7} {:>9} {:>6} {:>6} {:>7} {:>7} {:>9} {:>9} {:>9} {:>9}".format(
+        "offered", "sent/s", "sent", "done", "done/s", "drop", "qfull", "error", "invalid",
+        "disp p50", "p50 ms", "p99 ms", "p999 ms")
+    print(header)
+    print("-" * len(header))
+    for r in results:
+        print("{:>8.1f} {:>8.1f} {:>7} {:>7} {:>9.1f} {:>6} {:>6} {:>7} {:>7} {:>9.2f} {:>9.2f} {:>9.2f} {:>9.2f}".format(
+            r["offered_rate"], r["achieved_send_rate"], r["sent"], r["completed"], r["throughput"], r["dropped"],
+            r["queue_full"], r["errors"], r["invalid"] + r["malformed"], r["dispatch_ms"]["p50"],
+            r["completion_ms"]["p50"], r["completion_ms"]["p99"], r["completion_ms"]["p999"]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0],
+                                     formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument("--address", default="0.0.0.0", help="address to listen on")
+    parser.add_argument("--port", type=int, default=50000, help="port the flight computer connects to (its -u)")
+    parser.add_argument("--dictionary", required=True,
+                        help="topology dictionary (.json or .xml) to take opcodes and event ids from")
+    parser.add_argument("--mix", default=DEFAULT_MIX, help="weighted command mix, instance.MNEMONIC=weight,...")
+    parser.add_argument("--rates", default="10,20,50,100,200", help="offered command rates (commands/s) to step through")
+    parser.add_argument("--duration", type=float, default=10.0, help="seconds of sending per rate")
+    parser.add_argument("--drain", type=float, default=5.0, help="seconds to wait for responses after each rate")
+    parser.add_argument("--warmup", type=float, default=3.0, help="seconds to wait after connect before the first rate")
+    parser.add_argument("--arrivals", choices=("fixed", "poisson"), default="fixed", help="inter-send spacing")
+    parser.add_argument("--seed", type=int, default=1, help="seed for the mix and arrival draws")
+    parser.add_argument("--stop-on-loss", action="store_true", help="stop stepping at the first rate that loses commands")
+    parser.add_argument("--json", help="also write the results to this file")
+    args = parser.parse_args()
+
+    opcodes, events = load_dictionary(args.dictionary)
+    missing = [name for name in REQUIRED_EVENTS if name not in events]
+    if missing:
+        parser.error("{} lacks the events {}".format(args.dictionary, ", ".join(missing)))
+    try:
+        names, codes, weights = parse_mix(args.mix, opcodes)
+    except ValueError as error:
+        parser.error(str(error))
+    rates = [float(rate) for rate in args.rates.split(",")]
+
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind((args.address, args.port))
+    server.listen(1)
+    print("Waiting for the flight computer on {}:{}".format(args.address, args.port), flush=True)
+    connection, peer = server.accept()
+    connection.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    print("Connected from {}:{}, mix {}".format(peer[0], peer[1], ", ".join(
+        "{}={:g}".format(n, w) for n, w in zip(names, weights))), flush=True)
+    ground = Ground(connection, events)
+    time.sleep(args.warmup)
+
+    rng = random.Random(args.seed)
+    results = []
+    for rate in rates:
+        result = run_step(ground, rate, args.duration, args.drain, args.arrivals, codes, weights, rng)
+        results.append(result)
+        print("{:.1f} cmd/s: {} sent, {} completed, {} dropped, {} queue-full, p99 {:.2f} ms".format(
+            rate, result["sent"], result["completed"], result["dropped"], result["queue_full"],
+            result["completion_ms"]["p99"]), flush=True)
+        if not ground.link_up:
+            print("Flight computer closed the connection (cmdDisp queue overflow asserts)", flush=True)
+            break
+        if args.stop_on_loss and (result["dropped"] or result["queue_full"]):
+            break
+
+    print()
+    print_table(results)
+    lossless = [r["offered_rate"] for r in results if not (r["dropped"] or r["queue_full"] or r["errors"])]
+    print()
+    print("Highest lossless offered rate: {}".format("{:.1f} cmd/s".format(max(lossless)) if lossless else "none"))
+    print("Bad downlink frames: {}".format(ground.deframer.bad_frames))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"mix": dict(zip(names, weights)), "link_up": ground.link_up, "results": results}, f, indent=2)
+
+    connection.close()
+    server.close()
+    return 0 if ground.link_up else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -164,6 +164,12 @@ case $1 in
       "test")
         run_docker_compose "gds pytest -s -v"
       ;;
+      "load")
+        # Stand-in ground station: start this instead of the gds, then exec FlightComputer against it. It runs on the
+        # host, where the dictionary is under ${SCRIPT_DIR} rather than the container's ${FSW_WDIR}.
+        DICT_PATH="${SCRIPT_DIR}${DICT_DIR#${FSW_WDIR}}FlightComputerTopologyDictionary.json"
+        exec_cmd "python3 ${SCRIPT_DIR}/FlightComputer/test/load/uplink_load.py --port ${UPLINK_TARGET_PORT} --dictionary ${DICT_PATH} ${*:3}"
+      ;;
       *)
       echo "Invalid operation."
       exit 1